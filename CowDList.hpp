@@ -0,0 +1,371 @@
+// CowDList.hpp
+#ifndef CowDList_hpp
+#define CowDList_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "DList.hpp"
+
+/// list with the same interface as DList whose copies share one DList until either side
+/// is modified: copying is O(1), and the first mutation of a shared list (append,
+/// insert, pop, remove, clear, extend or non-const operator[]) clones it, so copies that
+/// are only read never copy a node; a reference returned by non-const operator[] is
+/// invalidated when the list is next copied; a new or moved-from CowDList holds no
+/// DList at all until it is first modified, so constructing and moving never allocate
+///
+/// const members read the shared DList only through its const members, which any
+/// number of threads may call at once, so threads may read a CowDList, or copies
+/// sharing its list, at once
+///
+/// copies may be made, mutated and destroyed on different threads: a mutation clones
+/// the list unless use_count() shows this object as its only owner, and then the list
+/// is written in place; use_count() is only a relaxed load, so it is followed by an
+/// acquire fence, which orders those writes after the reads the former owners made
+/// before releasing the list as long as std::shared_ptr releases its count with
+/// release ordering (libstdc++, libc++ and MSVC's all do; the standard does not say);
+/// as with any type, one CowDList object must not be mutated while another thread
+/// reads or copies it
+template <typename ItemType, typename Allocator = std::allocator<ItemType>>
+class CowDList {
+
+public:
+    using allocator_type = Allocator;
+
+    /// constructor
+    CowDList();
+
+    /// constructor that obtains the list and its nodes from alloc once it is first needed
+    /// @param alloc allocator to use for the list and its nodes
+    explicit CowDList(const Allocator& alloc) noexcept;
+
+    /// copy constructor; shares the source's list, and with it the source's allocator, in O(1)
+    CowDList(const CowDList& source) = default;
+
+    /// move constructor; takes over the source's list and leaves the source empty,
+    /// without allocating
+    /// @param source list to take the items of
+    CowDList(CowDList&& source) noexcept;
+
+    /// assignment operator; shares the source's list in O(1), unless the allocators
+    /// differ and do not propagate on copy assignment, in which case this list keeps its
+    /// allocator and copies the items
+    /// @param source list to share or copy the items of
+    CowDList& operator=(const CowDList& source);
+
+    /// move assignment operator; takes over the source's list and leaves the source
+    /// empty, unless the allocators differ and do not propagate on move assignment, in
+    /// which case the items are copied
+    /// @param source list to take the items of
+    CowDList& operator=(CowDList&& source) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+        || std::allocator_traits<Allocator>::is_always_equal::value);
+
+    /// returns the number of items in the list
+    size_t length() const { return _list ? _list->length() : 0; }
+
+    /// returns the number of CowDList objects sharing this list's items, or 0 while this
+    /// object holds no list (new or moved from, and not modified since); a hint only while
+    /// other threads copy or destroy sharing objects
+    long use_count() const { return _list.use_count(); }
+
+    /// item at index specified by position
+    /// @param position index of item to return
+    /// @return item at index specified by position, or ItemType{} if out of range
+    ItemType operator[](long position) const;
+
+    /// reference to item at index specified by position; clones the list first if it
+    /// is shared, even when the reference is only read, so read shared lists through a
+    /// const reference
+    /// @param position index of item to return
+    /// @return reference to item at index specified by position
+    ItemType& operator[](long position);
+
+    /// removes all elements from the list; a shared list is left to its other owners
+    /// rather than cloned
+    void clear();
+
+    /// adds the value x onto the end of the list
+    /// @param x value to add to the end of the list
+    void append(const ItemType& x);
+
+    /// adds the value x onto the end of the list, moving it into the new node
+    /// @param x value to add to the end of the list
+    void append(ItemType&& x);
+
+    /// inserts x at the index (negative or non-negative) at the specified position; note if
+    /// position is beyond the end, it adds to the end of the list or if position is beyond
+    /// the beginning it inserts at the beginning
+    /// @param position index to insert at
+    /// @param x value to insert at specified position
+    void insert(long position, const ItemType& x);
+
+    /// inserts x as insert(position, const ItemType&) does, moving it into the new node
+    /// @param position index to insert at
+    /// @param x value to insert at specified position
+    void insert(long position, ItemType&& x);
+
+    /// remove and return element at index specified by position; an invalid position
+    /// leaves a shared list shared
+    /// @param position index of element to remove
+    ItemType pop(long position = -1);
+
+    /// removes element from the list; if x is absent a shared list stays shared
+    /// @param x element to remove
+    void remove(ItemType x);
+
+    /// returns non-negative index of x starting at index start
+    /// @param x value to find the index of
+    /// @return non-negative index of x or -1 if not found
+    size_t index(ItemType x, size_t start = 0) const {
+        return _list ? std::as_const(*_list).index(x, start) : static_cast<size_t>(-1);
+    }
+
+    /// returns number of copies of x in the list
+    /// @param x value to count
+    /// @return number of copies of x in the list
+    int count(ItemType x) const { return _list ? _list->count(x) : 0; }
+
+    /// adds each element of otherList onto this list
+    /// @param otherList list to add the elements of
+    void extend(const CowDList& otherList);
+
+    /// returns a copy of the allocator used by this list
+    allocator_type get_allocator() const { return _alloc; }
+
+    /// returns the bytes of this object plus those of the shared list, which are
+    /// counted in full by every list sharing it
+    size_t bytes_used() const { return sizeof(CowDList) + (_list ? _list->bytes_used() : 0); }
+
+private:
+    using _List = DList<ItemType, Allocator>;
+    using _ListAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_List>;
+    using _ListTraits = std::allocator_traits<_ListAllocator>;
+
+    // destroys a list made by _new_list and returns its storage to the allocator
+    struct _ListDeleter {
+        void operator()(_List* list) const {
+            _ListAllocator alloc(_alloc);
+            std::destroy_at(list);
+            _ListTraits::deallocate(alloc, list, 1);
+        }
+        _ListAllocator _alloc;
+    };
+
+    /// returns a new list holding a copy of the items of source, if any, whose object,
+    /// nodes and shared_ptr control block are obtained from _alloc
+    /// @param source list to copy the items of, or nullptr for an empty list
+    std::shared_ptr<_List> _new_list(const _List* source) const;
+
+    /// returns true if other objects share the list; false means this object is the
+    /// sole owner and may write the list in place
+    bool _shared() const;
+
+    /// gives this object a list of its own: a new empty one if it holds none, or a clone
+    /// of the list it shares
+    void _unshare();
+
+    // allocator of the list and its nodes, kept here so an object without a list has one
+    Allocator _alloc;
+
+    // the list, possibly shared with copies of this object; nullptr until the first
+    // mutation of a new object and after a move
+    std::shared_ptr<_List> _list;
+};
+
+
+template <typename ItemType, typename Allocator>
+CowDList<ItemType, Allocator>::CowDList() : CowDList(Allocator()) {
+}
+
+template <typename ItemType, typename Allocator>
+CowDList<ItemType, Allocator>::CowDList(const Allocator& alloc) noexcept : _alloc(alloc) {
+}
+
+template <typename ItemType, typename Allocator>
+CowDList<ItemType, Allocator>::CowDList(CowDList&& source) noexcept
+	: _alloc(source._alloc), _list(std::move(source._list)) {
+}
+
+template <typename ItemType, typename Allocator>
+CowDList<ItemType, Allocator>& CowDList<ItemType, Allocator>::operator=(const CowDList& source) {
+	if (this != &source) {
+		if constexpr (!std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+			if (!(_alloc == source._alloc)) {
+				// a list on the source's allocator cannot become this one's
+				_list = source._list ? _new_list(source._list.get()) : nullptr;
+				return *this;
+			}
+		}
+		else {
+			_alloc = source._alloc;
+		}
+		_list = source._list;
+	}
+	return *this;
+}
+
+template <typename ItemType, typename Allocator>
+CowDList<ItemType, Allocator>& CowDList<ItemType, Allocator>::operator=(CowDList&& source) noexcept(
+	std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+	|| std::allocator_traits<Allocator>::is_always_equal::value) {
+	if (this != &source) {
+		if constexpr (!std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value) {
+			if (!(_alloc == source._alloc)) {
+				_list = source._list ? _new_list(source._list.get()) : nullptr;
+				source._list = nullptr;
+				return *this;
+			}
+		}
+		else {
+			_alloc = source._alloc;
+		}
+		_list = std::move(source._list);
+	}
+	return *this;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType CowDList<ItemType, Allocator>::operator[](long position) const {
+	long size = static_cast<long>(length());
+	if (position >= size || position < -size) {
+		return ItemType{};
+	}
+	return std::as_const(*_list)[position];
+}
+
+template <typename ItemType, typename Allocator>
+ItemType& CowDList<ItemType, Allocator>::operator[](long position) {
+	_unshare();
+	return (*_list)[position];
+}
+
+template <typename ItemType, typename Allocator>
+void CowDList<ItemType, Allocator>::clear() {
+	if (_shared()) {
+		_list = nullptr; // left to the other owners
+		return;
+	}
+	if (_list) {
+		_list->clear();
+	}
+}
+
+template <typename ItemType, typename Allocator>
+void CowDList<ItemType, Allocator>::append(const ItemType& x) {
+	if (_shared()) {
+		ItemType value(x); // x may refer to an item of the shared list
+		_unshare();
+		_list->append(std::move(value));
+		return;
+	}
+	_unshare();
+	_list->append(x);
+}
+
+template <typename ItemType, typename Allocator>
+void CowDList<ItemType, Allocator>::append(ItemType&& x) {
+	_unshare();
+	_list->append(std::move(x));
+}
+
+template <typename ItemType, typename Allocator>
+void CowDList<ItemType, Allocator>::insert(long position, const ItemType& x) {
+	if (_shared()) {
+		ItemType value(x); // x may refer to an item of the shared list
+		_unshare();
+		_list->insert(position, std::move(value));
+		return;
+	}
+	_unshare();
+	_list->insert(position, x);
+}
+
+template <typename ItemType, typename Allocator>
+void CowDList<ItemType, Allocator>::insert(long position, ItemType&& x) {
+	_unshare();
+	_list->insert(position, std::move(x));
+}
+
+template <typename ItemType, typename Allocator>
+ItemType CowDList<ItemType, Allocator>::pop(long position) {
+	long size = static_cast<long>(length());
+	if (position >= size || position < -size) {
+		return ItemType{};
+	}
+	_unshare();
+	return _list->pop(position);
+}
+
+template <typename ItemType, typename Allocator>
+void CowDList<ItemType, Allocator>::remove(ItemType x) {
+	if (!_list || (_shared() && index(x) == static_cast<size_t>(-1))) {
+		return;
+	}
+	_unshare();
+	_list->remove(x);
+}
+
+template <typename ItemType, typename Allocator>
+void CowDList<ItemType, Allocator>::extend(const CowDList& otherList) {
+	if (&otherList == this) {
+		_unshare();
+		_list->extend(*_list);
+		return;
+	}
+	// keep the other list alive and unchanged while this one may be replaced by a clone
+	auto other = otherList._list;
+	if (!other) {
+		return;
+	}
+	_unshare();
+	_list->extend(*other);
+}
+
+template <typename ItemType, typename Allocator>
+std::shared_ptr<typename CowDList<ItemType, Allocator>::_List> CowDList<ItemType, Allocator>::_new_list(const _List* source) const {
+	// placement new rather than std::allocate_shared: a pmr allocator would try
+	// uses-allocator construction of the DList, which has no allocator-extended constructors
+	_ListAllocator alloc(_alloc);
+	auto list = _ListTraits::allocate(alloc, 1);
+	try {
+		::new (static_cast<void*>(list)) _List(_alloc);
+	}
+	catch (...) {
+		_ListTraits::deallocate(alloc, list, 1);
+		throw;
+	}
+	// on a throw the shared_ptr constructor hands the list to the deleter
+	std::shared_ptr<_List> result(list, _ListDeleter{alloc}, alloc);
+	if (source != nullptr) {
+		// extend rather than copy-construct, so the clone stays on _alloc
+		result->extend(*source);
+	}
+	return result;
+}
+
+template <typename ItemType, typename Allocator>
+bool CowDList<ItemType, Allocator>::_shared() const {
+	if (_list.use_count() > 1) {
+		return true;
+	}
+	// use_count() is a relaxed load; order the writes that follow after the reads the
+	// former owners made before they released the list
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return false;
+}
+
+template <typename ItemType, typename Allocator>
+void CowDList<ItemType, Allocator>::_unshare() {
+	if (!_list) {
+		_list = _new_list(nullptr);
+	}
+	else if (_shared()) {
+		_list = _new_list(_list.get());
+	}
+}
+
+#endif /* CowDList_hpp */
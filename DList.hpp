@@ -2,19 +2,116 @@
 #ifndef DList_hpp
 #define DList_hpp
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "DListNode.hpp"
-template <typename ItemType>
+
+/// memory held by a DList, as reported by DList::stats()
+struct DListStats {
+    // bytes of the list object plus all node storage obtained from its allocator
+    size_t bytes_used;
+    // bytes of the items themselves (length() * sizeof(ItemType))
+    size_t payload_bytes;
+    // bytes_used - payload_bytes: links, cached nodes and the list object
+    size_t structural_bytes;
+    // nodes holding items, and retired nodes kept for reuse
+    size_t live_nodes;
+    size_t cached_nodes;
+    // node allocations and deallocations made by this list over its lifetime; a node
+    // moved to another list by splice, extend or a node handle takes its allocation
+    // with it, so allocations - deallocations is always live_nodes + cached_nodes
+    unsigned long long allocations;
+    unsigned long long deallocations;
+    // entries in the position directory, how often it was rebuilt and the nodes
+    // those rebuilds walked in total
+    size_t directory_entries;
+    unsigned long long directory_rebuilds;
+    unsigned long long directory_rebuild_steps;
+};
+
+/// memory resource whose freed blocks any list on it can reuse, such as DListArena; a
+/// pmr::DList constructed on one keeps no node cache of its own, since the nodes it
+/// cached would be out of reach of the other lists
+class DListSharedResource : public std::pmr::memory_resource {
+
+public:
+    /// returns true if the resource reclaims all of its blocks at once, so a pmr::DList of
+    /// trivially destructible items may be destroyed without walking and freeing its nodes
+    bool release_only() const noexcept { return _releaseOnly; }
+
+protected:
+    // set by resources that let lists abandon their nodes on destruction
+    bool _releaseOnly = false;
+};
+
+/// doubly linked list with a Python list-like interface; nodes are obtained from
+/// Allocator (rebound to DListNode<ItemType>), which defaults to std::allocator
+///
+/// positional lookups remember the last node they resolved (the finger) and start
+/// from whichever of the finger, the head and the tail is closest, so sequential
+/// operator[] sweeps are amortized O(1) per step; lists of directory_min_length items
+/// or more also keep a directory of every ~sqrt(n)-th node and its index, so a random
+/// lookup walks O(sqrt n) nodes; insert and pop shift the directory's indices in place,
+/// and after ~sqrt(n) of them it is dropped and rebuilt by the next lookup that needs it
+/// (see DListStats::directory_rebuilds); const members may be called from several
+/// threads at once: one const lookup at a time uses and moves the finger and the
+/// directory, and a lookup that finds them in use walks from the nearer end instead
+template <typename ItemType, typename Allocator = std::allocator<ItemType>>
 class DList {
 
 public:
+    using allocator_type = Allocator;
+
+    /// number of retired nodes a new list keeps for reuse; a list on a
+    /// DListSharedResource keeps none
+    static constexpr size_t default_node_cache_limit = 64;
+
+    /// smallest length at which lookups build the position directory
+    static constexpr long directory_min_length = 1024;
+
     /// constructor
     DList();
 
+    /// constructor that obtains all nodes from alloc
+    /// @param alloc allocator to use for this list's nodes
+    explicit DList(const Allocator& alloc);
+
     /// copy constructor
     DList(const DList& source);
 
+    /// move constructor; takes over the nodes, cached nodes, finger and directory of
+    /// source in O(1) and leaves source empty
+    DList(DList&& source) noexcept;
+
+    /// destructor; frees the nodes iteratively so long lists cannot exhaust the stack
+    ~DList();
+
     /// assignment operator
     DList& operator=(const DList& source);
+
+    /// move assignment operator; O(1) plus freeing this list's old nodes when the
+    /// allocator propagates or both allocators are equal, otherwise the items of source
+    /// are copied into nodes from this list's allocator; source is left empty either way
+    DList& operator=(DList&& source) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+        || std::allocator_traits<Allocator>::is_always_equal::value);
+
+    /// exchanges the contents of this list and other in O(1); the allocators are
+    /// exchanged only if they propagate on swap, otherwise they must compare equal
+    /// @param other list to exchange contents with
+    void swap(DList& other) noexcept;
     /// returns the number of items in the list
     size_t length() const { return _size; }
 
@@ -28,13 +125,23 @@ public:
     /// @return reference to item at index specified by position
     ItemType& operator[](long position);
 
-    /// removes all elements from the list
+    /// removes all elements from the list in O(n) time and O(1) stack space
     void clear();
 
     /// adds the value x onto the end of the list
     /// @param x value to add to the end of the list
     void append(const ItemType& x);
 
+    /// adds the value x onto the end of the list, moving it into the new node
+    /// @param x value to add to the end of the list
+    void append(ItemType&& x);
+
+    /// adds an item constructed in place from args onto the end of the list
+    /// @param args arguments forwarded to ItemType's constructor
+    /// @return reference to the new item
+    template <typename... Args>
+    ItemType& emplace_back(Args&&... args);
+
     /// inserts x at the index (negative or non-negative) at the specified poition; note if
     /// position is beyond the end, it adds to the end of the list or if position is beyond
     /// the beginning it inserts at the beginning
@@ -42,10 +149,68 @@ public:
     /// @param x value to insert at specified position
     void insert(long position, const ItemType& x);
 
+    /// inserts x as insert(position, const ItemType&) does, moving it into the new node
+    /// @param position index to insert at
+    /// @param x value to insert at specified position
+    void insert(long position, ItemType&& x);
+
+    /// handle that owns a node taken out of a DList by extract, modeled after the node
+    /// handles of std::map; an empty handle holds no node
+    class node_type;
+
+    /// unlinks the node at index specified by position and returns it in a handle, so
+    /// the element can be inserted into another list without touching an allocator
+    /// or copying the item; an invalid position gives an empty handle
+    /// @param position index (negative or non-negative) of the element to take
+    /// @return handle owning the node, or an empty handle
+    node_type extract(long position);
+
+    /// links the node held by node in at the index (negative or non-negative) at the
+    /// specified position, clamped as insert does, and leaves node empty; no allocation
+    /// happens unless the node's allocator differs from this list's, in which case its
+    /// item is moved into a new node; an empty handle inserts nothing
+    /// @param position index to insert at
+    /// @param node handle holding the node to insert
+    void insert(long position, node_type&& node);
+
+    /// links the node held by node in at the end of the list, as insert(length(), node) does
+    /// @param node handle holding the node to append
+    void append(node_type&& node);
+
+    /// inserts an item constructed in place from args at the index (negative or
+    /// non-negative) at the specified position, clamped as insert does
+    /// @param position index to insert at
+    /// @param args arguments forwarded to ItemType's constructor
+    /// @return reference to the new item
+    template <typename... Args>
+    ItemType& emplace(long position, Args&&... args);
+
+    /// inserts every (position, value) pair with the same result as calling insert for
+    /// each pair in order, including its clamping of positions beyond either end; the
+    /// final slot of each value is computed up front, all nodes are created before any
+    /// link changes, and they are merged into the list in one traversal, so k inserts
+    /// cost O(n + k log(n + k)) instead of O(n * k)
+    /// @param entries index to insert at (relative to the list as it is when that pair's
+    /// turn comes) and value to insert, in the order the inserts apply
+    void insert_many(const std::vector<std::pair<long, ItemType>>& entries);
+
     /// remove and return element at index specified by position
     /// @param position index of element to remove
     ItemType pop(long position = -1);
 
+    /// removes the elements at a set of indices in one sweep; each index is normalized
+    /// the way pop does, indices out of range are skipped and repeats count once, so
+    /// indices refer to the list as it was before the call
+    /// @param positions indices (negative or non-negative) in any order
+    /// @return number of elements removed
+    size_t delete_many(const std::vector<long>& positions);
+
+    /// removes and returns the elements at a set of indices in one sweep, with the
+    /// same index handling as delete_many
+    /// @param positions indices (negative or non-negative) in any order
+    /// @return removed elements, in ascending order of their former index
+    std::vector<ItemType> pop_many(const std::vector<long>& positions);
+
     /// removes element from the list
     /// @param x element to remove
     void remove(ItemType x);
@@ -64,86 +229,581 @@ public:
     /// @param otherList list to add the elements of
     void extend(const DList& otherList);
 
+    /// moves every element of otherList onto the end of this list and leaves otherList
+    /// empty; O(1) when the allocators compare equal, since the nodes are relinked,
+    /// otherwise the items are moved into new nodes one by one
+    /// @param otherList list to take the elements of
+    void extend(DList&& otherList);
+
+    /// moves the elements of other at indices [first, last) so they sit before index
+    /// position of this list, relinking their nodes when the allocators compare equal
+    /// (otherwise the items are moved into new nodes); first and last are normalized as
+    /// by slice, and position is clamped as by insert and refers to this list before the
+    /// call; other may be this list, in which case nothing changes if position lies in
+    /// [first, last]; the cost is the walks to first, last and position, since the
+    /// number of elements moved follows from the indices
+    /// @param position index of this list to move the elements before
+    /// @param other list to take the elements from
+    /// @param first index of the first element to move
+    /// @param last index the range stops before
+    void splice(long position, DList& other, long first, long last = LONG_MAX);
+
+    /// returns a new list with the items of the Python slice [start:stop:step], using
+    /// Python's normalization: negative bounds count from the end and bounds beyond
+    /// either end are clamped; pass LONG_MAX / LONG_MIN for an omitted bound (e.g.
+    /// slice(LONG_MAX, LONG_MIN, -1) is [::-1]); a step of 0 gives an empty list; the
+    /// items are visited in one walk that starts from the node closest to start
+    /// @param start index of the first item
+    /// @param stop index the slice stops before
+    /// @param step distance between items; negative to walk backwards
+    /// @return list using this list's allocator
+    DList slice(long start, long stop = LONG_MAX, long step = 1) const;
+
+    /// replaces the Python slice [start:stop:step] with the items of values, as Python's
+    /// slice assignment does: with step 1 the range is relinked to hold values whatever
+    /// its length (an empty range inserts at start), in O(distance to the slice + slice
+    /// length + values length); with any other step values must have exactly one item
+    /// per slice position, otherwise nothing changes; a step of 0 changes nothing;
+    /// values may be this list
+    /// @param start index of the first item, normalized as by slice
+    /// @param stop index the slice stops before, normalized as by slice
+    /// @param step distance between items; negative to walk backwards
+    /// @param values items to store
+    void assign_slice(long start, long stop, long step, const DList& values);
+
+    /// removes the items of the Python slice [start:stop:step] in one walk and frees
+    /// their nodes in bulk; a step of 0 removes nothing
+    /// @param start index of the first item, normalized as by slice
+    /// @param stop index the slice stops before, normalized as by slice
+    /// @param step distance between items; negative to walk backwards
+    /// @return number of items removed
+    size_t delete_slice(long start, long stop, long step = 1);
+
+    /// returns the items at many indices, resolved in one pass over the list in index
+    /// order; O(n + k log k) for k indices instead of a separate lookup for each
+    /// @param positions indices (negative or non-negative) in any order, repeats allowed
+    /// @return item at each index, in the order of positions; ItemType{} for an index
+    /// out of range
+    std::vector<ItemType> get_many(const std::vector<long>& positions) const;
+
+    /// stores values[i] at index positions[i] for every pair, resolved in one pass over
+    /// the list; indices out of range are skipped, and when an index repeats the
+    /// value that comes last in positions is kept
+    /// @param positions indices (negative or non-negative) in any order
+    /// @param values value for each index; extra entries in the longer vector are ignored
+    void set_many(const std::vector<long>& positions, const std::vector<ItemType>& values);
+
+    /// returns a copy of the allocator used by this list
+    allocator_type get_allocator() const { return allocator_type(_alloc); }
+
+    /// returns the number of retired nodes currently kept for reuse
+    size_t cached_nodes() const { return _cacheSize; }
+
+    /// returns the maximum number of retired nodes kept for reuse
+    size_t node_cache_limit() const { return _cacheLimit; }
+
+    /// sets the maximum number of retired nodes kept for reuse; nodes cached beyond
+    /// the new limit are released immediately
+    /// @param limit high-water mark of the node cache (0 disables recycling)
+    void set_node_cache_limit(size_t limit);
+
+    /// releases every retired node kept for reuse back to the allocator
+    void shrink_to_fit();
+
+    /// returns the bytes of the list object plus all node and directory storage it holds
+    /// from its allocator, cached nodes included; heap memory owned by the items is not counted
+    size_t bytes_used() const {
+        _CacheGuard guard(*this, true);
+        return _bytes_used();
+    }
+
+    /// returns the bytes each node spends on links and padding next to its item
+    static constexpr size_t node_overhead() { return sizeof(_Node) - sizeof(ItemType); }
+
+    /// returns the memory usage and allocation counters of this list
+    DListStats stats() const;
+
 private:
+    using _Node = DListNode<ItemType>;
+    using _NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_Node>;
+    using _NodeTraits = std::allocator_traits<_NodeAllocator>;
+
+    // storage of a retired node while it sits in the node cache
+    struct _CachedNode {
+        _CachedNode* _next;
+    };
+
+    // position directory entry: a node and its index minus _directoryBias
+    struct _DirEntry {
+        _Node* _node;
+        long _position;
+    };
+    using _DirAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_DirEntry>;
+    using _Directory = std::vector<_DirEntry, _DirAllocator>;
+
+    /// constructs a node in storage taken from the node cache, or newly obtained
+    /// from the list's allocator if the cache is empty
+    /// @param prev node before the new node
+    /// @param next node after the new node
+    /// @param args arguments forwarded to ItemType's constructor
+    /// @return the new node
+    template <typename... Args>
+    _Node* _new_node(_Node* prev, _Node* next, Args&&... args);
+
+    /// destroys a node obtained from _new_node and keeps its storage in the node cache,
+    /// or deallocates it if the cache is full
+    /// @param node node to free
+    void _delete_node(_Node* node);
 
-    /// helper function for copy constructor and operator=
+    /// fills the node cache up to count nodes, allocating the shortfall in one pass before
+    /// any item is constructed, so the nodes of a batch are obtained back to back; the cache
+    /// may hold more than its limit until the batch takes the nodes or set_node_cache_limit()
+    /// trims it; if an allocation throws, the cache is trimmed to its limit
+    /// @param count number of nodes the caller is about to create
+    void _reserve_nodes(size_t count);
+
+    /// returns the node cache limit of a new list using alloc
+    /// @param alloc allocator of the new list
+    /// @return 0 on a DListSharedResource, default_node_cache_limit otherwise
+    static size_t _initial_cache_limit(const Allocator& alloc);
+
+    /// returns true if destruction may leave the nodes to the resource: the items are
+    /// trivially destructible and the resource is a DListSharedResource in release-only mode
+    bool _abandons_nodes() const;
+
+    /// helper function for copy constructor and operator=; if a copy throws, the nodes
+    /// made so far are freed and the list is left empty
     /// @param source existing DList to make a copy of its nodes for and store in this
     void _copy(const DList& source);
 
-    /// returns node at specified index
+    /// helper function for the move constructor and move assignment: takes the nodes,
+    /// node cache, counters, finger and directory of source, which must use an equal
+    /// allocator, and leaves it empty; this list must hold no nodes and no cached nodes
+    /// @param source list to take the contents of
+    void _take(DList& source) noexcept;
+
+    // holds _cacheBusy while a const member reads or moves the finger and the directory;
+    // without wait it gives up at once if another thread holds it
+    class _CacheGuard {
+    public:
+        _CacheGuard(const DList& list, bool wait) : _busy(list._cacheBusy) {
+            _owns = !_busy.exchange(true, std::memory_order_acquire);
+            while (!_owns && wait) {
+                std::this_thread::yield();
+                _owns = !_busy.exchange(true, std::memory_order_acquire);
+            }
+        }
+        ~_CacheGuard() {
+            if (_owns) {
+                _busy.store(false, std::memory_order_release);
+            }
+        }
+        _CacheGuard(const _CacheGuard&) = delete;
+        _CacheGuard& operator=(const _CacheGuard&) = delete;
+        bool owns() const { return _owns; }
+
+    private:
+        std::atomic<bool>& _busy;
+        bool _owns;
+    };
+
+    /// bytes_used() without taking _cacheBusy
+    size_t _bytes_used() const {
+        return sizeof(DList) + (static_cast<size_t>(_size) + _cacheSize) * sizeof(_Node)
+            + _directory.capacity() * sizeof(_DirEntry);
+    }
+
+    /// returns node at specified index, or nullptr if position is out of range
     /// @param position index from -length() to length()
     /// @return node at specified position or nullptr if position is out of range
-    std::shared_ptr<DListNode<ItemType>> _find(long position) const;
+    _Node* _find(long position) const;
+
+    /// _find for const members: seeks as _seek_shared does
+    /// @param position index from -length() to length()
+    /// @return node at specified position or nullptr if position is out of range
+    _Node* _find_shared(long position) const;
+
+    /// positional seek every lookup goes through: walks to the node at a valid index
+    /// from whichever of _head, _tail, the finger and the directory entries is closest,
+    /// so no lookup walks more than half the list, and moves the finger to that node
+    /// @param position non-negative index below length()
+    /// @return node at specified position
+    _Node* _seek(long position) const;
+
+    /// positional seek for const members, which may run on several threads at once: seeks
+    /// as _seek does if _cacheBusy is free, and otherwise walks as _walk does
+    /// @param position non-negative index below length()
+    /// @return node at specified position
+    _Node* _seek_shared(long position) const;
+
+    /// walks to the node at a valid index from the nearer of _head and _tail without
+    /// reading or writing the finger and the directory
+    /// @param position non-negative index below length()
+    /// @return node at specified position
+    _Node* _walk(long position) const;
+
+    /// returns the spacing of directory entries for the current length (~sqrt(n))
+    long _directory_block() const;
+
+    /// rebuilds the directory with an entry for every _directory_block()-th node
+    void _build_directory() const;
+
+    /// returns the index of the first directory entry at or after position
+    /// @param position non-negative index
+    size_t _directory_lower_bound(long position) const;
+
+    /// adds delta to the index of every directory entry from first on, updating
+    /// whichever side of first has fewer entries
+    /// @param first first entry to shift
+    /// @param delta +1 or -1
+    void _directory_shift(size_t first, long delta);
+
+    /// counts a mutation against the directory and drops it once the directory has
+    /// seen more mutations than its block size
+    /// @return true if the directory is still in use and must be adjusted
+    bool _directory_mutated();
+
+    /// keeps the finger and the directory on their nodes after a node was inserted at position
+    /// @param position non-negative index of the inserted node
+    void _note_insert(long position);
+
+    /// keeps the finger and the directory valid after the node at position was unlinked
+    /// @param position non-negative index the removed node had
+    /// @param next node that followed the removed node
+    void _note_erase(long position, _Node* next);
+
+    /// forgets the finger and drops the directory, after the links changed wholesale
+    void _note_reset();
 
     /// remove and return the element at the specified index
     /// if index is invalid, it does nothing
     /// @param position index of element to remove
     ItemType _delete(long position);
 
-    // pointers to the head, and tail nodes
-    std::shared_ptr<DListNode<ItemType>> _head, _tail;
+    /// returns the in-range entries of positions, made non-negative and paired with their
+    /// slot in positions, sorted by index and then by slot
+    /// @param positions indices (negative or non-negative)
+    /// @param count number of leading entries of positions to use
+    std::vector<std::pair<long, size_t>> _sorted_positions(const std::vector<long>& positions, size_t count) const;
+
+    /// normalizes slice bounds the way Python's slice.indices does
+    /// @param start first index; replaced with its normalized value
+    /// @param stop index to stop before; replaced with its normalized value
+    /// @param step distance between items, not 0
+    /// @return number of items in the slice
+    long _slice_indices(long& start, long& stop, long step) const;
+
+    /// copies the items of source into a new chain of nodes that is not linked into this
+    /// list; if a copy throws, the nodes made so far are freed
+    /// @param source list to copy the items of
+    /// @param last set to the last node of the chain
+    /// @return first node of the chain, or nullptr if source is empty
+    _Node* _copy_chain(const DList& source, _Node*& last);
+
+    /// links a single detached node into the list at the index (negative or non-negative)
+    /// at the specified position, clamped as insert does
+    /// @param position index to insert at
+    /// @param node node to link in; its links are overwritten
+    void _insert_node(long position, _Node* node);
+
+    /// links a detached chain into the list before index position
+    /// @param position non-negative index no greater than length()
+    /// @param first first node of the chain
+    /// @param last last node of the chain
+    /// @param count number of nodes in the chain
+    void _link_chain(long position, _Node* first, _Node* last, long count);
+
+    /// unlinks node from the list and appends it to a detached chain; _size is not changed
+    /// @param node node to unlink
+    /// @param chain first node of the chain, set when the chain was empty
+    /// @param chainTail last node of the chain, set to node
+    void _detach(_Node* node, _Node*& chain, _Node*& chainTail);
+
+    /// unlinks count nodes spaced step apart in one forward walk
+    /// @param first non-negative index of the first node to unlink
+    /// @param count number of nodes to unlink, at least 1
+    /// @param step positive distance between the nodes
+    /// @return the unlinked nodes in index order, chained through _next and ending in nullptr
+    _Node* _unlink_stride(long first, long count, long step);
+
+    /// unlinks the nodes at a set of indices in one forward sweep
+    /// @param positions indices (negative or non-negative); out of range ones are skipped
+    /// @return the unlinked nodes in index order, chained through _next and ending in nullptr
+    _Node* _unlink_many(const std::vector<long>& positions);
+
+    /// frees every node of a detached chain by walking its _next links in a loop
+    /// @param first first node of the chain (may be nullptr); the chain must end in nullptr
+    void _free_chain(_Node* first);
+
+    // allocator the nodes are obtained from
+    _NodeAllocator _alloc;
+
+    // retired node storage available for reuse, its length and high-water mark
+    _CachedNode* _cache;
+    size_t _cacheSize;
+    size_t _cacheLimit;
+
+    // lifetime counts of node storage obtained from and returned to _alloc
+    unsigned long long _allocations;
+    unsigned long long _deallocations;
+
+    // pointers to the head, and tail nodes; the list owns every node between them
+    _Node* _head;
+    _Node* _tail;
 
     // number of items in the list
     long _size;
+
+    // last node resolved by _find and its index; nullptr when unknown
+    mutable _Node* _finger;
+    mutable long _fingerIndex;
+
+    // every ~sqrt(n)-th node with its index, ordered by index; empty while stale
+    mutable _Directory _directory;
+
+    // amount added to every stored _DirEntry::_position, so that shifting all entries
+    // past an index can update the shorter side instead
+    mutable long _directoryBias;
+
+    // spacing the directory was built with, and mutations it has absorbed since
+    mutable long _directoryBlock;
+    mutable long _directoryMutations;
+
+    // lifetime rebuild count and the nodes those rebuilds walked
+    mutable unsigned long long _directoryRebuilds;
+    mutable unsigned long long _directoryRebuildSteps;
+
+    // set while a const member owns the finger and the directory (see _CacheGuard);
+    // non-const members have the list to themselves and never take it
+    mutable std::atomic<bool> _cacheBusy{false};
 };
 
 
-template <typename ItemType>
-DList<ItemType>::DList() {
+template <typename ItemType, typename Allocator>
+DList<ItemType, Allocator>::DList() : DList(Allocator()) {
+}
+
+template <typename ItemType, typename Allocator>
+DList<ItemType, Allocator>::DList(const Allocator& alloc) : _alloc(alloc), _directory(_DirAllocator(alloc)) {
+	_cache = nullptr;
+	_cacheSize = 0;
+	_cacheLimit = _initial_cache_limit(alloc);
+	_allocations = 0;
+	_deallocations = 0;
 	_head = nullptr;
 	_tail = nullptr;
 	_size = 0;
+	_finger = nullptr;
+	_fingerIndex = 0;
+	_directoryBias = 0;
+	_directoryBlock = 0;
+	_directoryMutations = 0;
+	_directoryRebuilds = 0;
+	_directoryRebuildSteps = 0;
 }
 
-template <typename ItemType>
-DList<ItemType>::DList(const DList& source) {
-	_copy(source);
+template <typename ItemType, typename Allocator>
+DList<ItemType, Allocator>::DList(const DList& source)
+	: _alloc(_NodeTraits::select_on_container_copy_construction(source._alloc)), _directory(_DirAllocator(_alloc)) {
+	_cache = nullptr;
+	_cacheSize = 0;
+	_cacheLimit = source._cacheLimit;
+	_allocations = 0;
+	_deallocations = 0;
+	_finger = nullptr;
+	_fingerIndex = 0;
+	_directoryBias = 0;
+	_directoryBlock = 0;
+	_directoryMutations = 0;
+	_directoryRebuilds = 0;
+	_directoryRebuildSteps = 0;
+	try {
+		_copy(source);
+	}
+	catch (...) {
+		shrink_to_fit(); // the destructor will not run to free the nodes cached by the failed copy
+		throw;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+DList<ItemType, Allocator>::DList(DList&& source) noexcept
+	: _alloc(std::move(source._alloc)), _directory(_DirAllocator(_alloc)) {
+	_cache = nullptr;
+	_cacheSize = 0;
+	_cacheLimit = source._cacheLimit;
+	_take(source);
 }
 
-template <typename ItemType>
-DList<ItemType>& DList<ItemType>::operator=(const DList& source) {
+template <typename ItemType, typename Allocator>
+DList<ItemType, Allocator>::~DList() {
+	if (_abandons_nodes()) {
+		return; // the resource reclaims every node when it is released
+	}
+	_cacheLimit = 0;
+	_free_chain(_head);
+	shrink_to_fit();
+}
+
+template <typename ItemType, typename Allocator>
+DList<ItemType, Allocator>& DList<ItemType, Allocator>::operator=(const DList& source) {
 	if (this != &source) {
 		clear();
+		if constexpr (_NodeTraits::propagate_on_container_copy_assignment::value) {
+			shrink_to_fit(); // cached and directory storage belong to the old allocator
+			_alloc = source._alloc;
+			_directory = _Directory(_DirAllocator(_alloc));
+		}
 		_copy(source);
 	}
 	return *this;
 }
 
-template <typename ItemType>
-ItemType DList<ItemType>::operator[](long position) const {
-	return _find(position)->_item;
+template <typename ItemType, typename Allocator>
+DList<ItemType, Allocator>& DList<ItemType, Allocator>::operator=(DList&& source) noexcept(
+	std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+	|| std::allocator_traits<Allocator>::is_always_equal::value) {
+	if (this == &source) {
+		return *this;
+	}
+	clear();
+	shrink_to_fit(); // either storage of the old allocator, or replaced by source's cache
+	if constexpr (_NodeTraits::propagate_on_container_move_assignment::value) {
+		_alloc = std::move(source._alloc);
+		_directory = _Directory(_DirAllocator(_alloc));
+	}
+	else if (!(_alloc == source._alloc)) {
+		// the nodes cannot change hands, so copy the items and empty source
+		_copy(source);
+		source.clear();
+		return *this;
+	}
+	_take(source);
+	return *this;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::swap(DList& other) noexcept {
+	using std::swap;
+	if constexpr (_NodeTraits::propagate_on_container_swap::value) {
+		swap(_alloc, other._alloc);
+	}
+	swap(_cache, other._cache);
+	swap(_cacheSize, other._cacheSize);
+	swap(_cacheLimit, other._cacheLimit);
+	swap(_allocations, other._allocations);
+	swap(_deallocations, other._deallocations);
+	swap(_head, other._head);
+	swap(_tail, other._tail);
+	swap(_size, other._size);
+	swap(_finger, other._finger);
+	swap(_fingerIndex, other._fingerIndex);
+	_directory.swap(other._directory);
+	swap(_directoryBias, other._directoryBias);
+	swap(_directoryBlock, other._directoryBlock);
+	swap(_directoryMutations, other._directoryMutations);
+	swap(_directoryRebuilds, other._directoryRebuilds);
+	swap(_directoryRebuildSteps, other._directoryRebuildSteps);
+}
+
+template <typename ItemType, typename Allocator>
+ItemType DList<ItemType, Allocator>::operator[](long position) const {
+	return _find_shared(position)->_item;
 }
 
-template <typename ItemType>
-ItemType& DList<ItemType>::operator[](long position) {
+template <typename ItemType, typename Allocator>
+ItemType& DList<ItemType, Allocator>::operator[](long position) {
 	return _find(position)->_item;
 }
 
-template <typename ItemType>
-void DList<ItemType>::clear() {
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::clear() {
+	// detach the whole chain first so the list is already empty while it is freed
+	auto first = _head;
 	_head = nullptr;
 	_tail = nullptr;
 	_size = 0;
+	_note_reset();
+	_free_chain(first);
 }
 
-template <typename ItemType>
-void DList<ItemType>::append(const ItemType& x) {
-	auto newNode = std::make_shared<DListNode<ItemType>>(x);
-	if (_size == 0) {
-		_head = newNode;
-		_tail = newNode;
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::append(const ItemType& x) {
+	emplace_back(x);
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::append(ItemType&& x) {
+	emplace_back(std::move(x));
+}
+
+template <typename ItemType, typename Allocator>
+template <typename... Args>
+ItemType& DList<ItemType, Allocator>::emplace_back(Args&&... args) {
+	auto newNode = _new_node(nullptr, nullptr, std::forward<Args>(args)...);
+	_insert_node(_size, newNode);
+	return newNode->_item;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::insert(long position, const ItemType& x) {
+	emplace(position, x);
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::insert(long position, ItemType&& x) {
+	emplace(position, std::move(x));
+}
+
+template <typename ItemType, typename Allocator>
+template <typename... Args>
+ItemType& DList<ItemType, Allocator>::emplace(long position, Args&&... args) {
+	auto newNode = _new_node(nullptr, nullptr, std::forward<Args>(args)...);
+	_insert_node(position, newNode);
+	return newNode->_item;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::insert(long position, node_type&& node) {
+	if (node.empty()) {
+		return;
 	}
-	else {
-		_tail->_next = newNode;
-		newNode->_prev = _tail;
-		_tail = newNode;
+	if (!(_alloc == *node._alloc)) {
+		// the node belongs to another allocator; move its item into a node of our own
+		emplace(position, std::move(node._node->_item));
+		node = node_type();
+		return;
 	}
-	_size++;
+	_insert_node(position, node._node);
+	++_allocations; // the node's allocation arrives with it
+	node._node = nullptr;
+	node._alloc.reset();
 }
 
-template <typename ItemType>
-void DList<ItemType>::insert(long position, const ItemType& x) {
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::append(node_type&& node) {
+	insert(_size, std::move(node));
+}
 
+template <typename ItemType, typename Allocator>
+typename DList<ItemType, Allocator>::node_type DList<ItemType, Allocator>::extract(long position) {
+	if (position < 0) position += _size;
+	if (position < 0 || position >= _size) {
+		return node_type();
+	}
+	_Node* chain = nullptr;
+	_Node* chainTail = nullptr;
+	auto current = _seek(position);
+	auto next = current->_next;
+	_detach(current, chain, chainTail);
+	--_size;
+	_note_erase(position, next);
+	--_allocations; // the handle carries the node's allocation away
+	return node_type(current, _alloc);
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_insert_node(long position, _Node* node) {
 	if (position < 0) { // convert negative position to positive to insert at index
 		position += _size;
 	}
@@ -154,36 +814,159 @@ void DList<ItemType>::insert(long position, const ItemType& x) {
 		position = _size;
 	}
 
-	if (_size == 0 || position == _size) {
-		append(x);
+	if (position == _size) {
+		node->_prev = _tail;
+		node->_next = nullptr;
+		if (_tail) {
+			_tail->_next = node;
+		}
+		else {
+			_head = node;
+		}
+		_tail = node;
+	}
+	else {
+		auto current = _seek(position);
+		auto previous = current->_prev;
+		node->_prev = previous;
+		node->_next = current;
+		if (previous) {
+			previous->_next = node;
+		}
+		else {
+			_head = node;
+		}
+		current->_prev = node;
+	}
+	++_size;
+	_note_insert(position);
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::insert_many(const std::vector<std::pair<long, ItemType>>& entries) {
+	long k = static_cast<long>(entries.size());
+	if (k == 0) {
 		return;
 	}
+	long total = _size + k;
 
-	auto current = _find(position);
-	auto previous = current->_prev.lock();
-	auto newNode = std::make_shared<DListNode<ItemType>>(x, previous, current);
+	// Fenwick tree over the final slots, every slot free to start with
+	std::vector<long> tree(static_cast<size_t>(total) + 1);
+	for (long i = 1; i <= total; ++i) {
+		tree[i] = i & -i;
+	}
+	long top = 1;
+	while (top * 2 <= total) {
+		top *= 2;
+	}
 
-	if (previous) {
-		previous->_next = newNode;
+	// walking the inserts backwards, each one takes the free slot whose rank among the
+	// slots later inserts left free is its clamped index
+	std::vector<long> slots(static_cast<size_t>(k));
+	for (long j = k - 1; j >= 0; --j) {
+		long size = _size + j;
+		long position = entries[j].first;
+		if (position < 0) {
+			position += size;
+		}
+		if (position < 0) {
+			position = 0;
+		}
+		if (position > size) {
+			position = size;
+		}
+
+		long slot = 0;
+		long rank = position + 1;
+		for (long step = top; step > 0; step /= 2) {
+			if (slot + step <= total && tree[slot + step] < rank) {
+				slot += step;
+				rank -= tree[slot];
+			}
+		}
+		slots[j] = slot;
+		for (long i = slot + 1; i <= total; i += i & -i) {
+			--tree[i];
+		}
 	}
-	else {
-		_head = newNode;
+
+	// create every node before touching the links, so a throwing copy leaves the list as it was
+	std::vector<std::pair<long, _Node*>> created;
+	created.reserve(static_cast<size_t>(k));
+	_reserve_nodes(static_cast<size_t>(k));
+	try {
+		for (long j = 0; j < k; ++j) {
+			created.emplace_back(slots[j], _new_node(nullptr, nullptr, entries[j].second));
+		}
 	}
-	current->_prev = newNode;
-	++_size;
+	catch (...) {
+		for (auto& entry : created) {
+			_delete_node(entry.second);
+		}
+		set_node_cache_limit(_cacheLimit); // drop the reserved nodes the limit has no room for
+		throw;
+	}
+	std::sort(created.begin(), created.end());
+
+	// the r-th new node in slot order goes right before the old item at index slot - r
+	long oldIndex = created[0].first;
+	auto current = _find(oldIndex);
+	for (long r = 0; r < k; ++r) {
+		while (oldIndex < created[r].first - r) {
+			current = current->_next;
+			++oldIndex;
+		}
+		auto node = created[r].second;
+		auto previous = current != nullptr ? current->_prev : _tail;
+		node->_prev = previous;
+		node->_next = current;
+		if (previous) {
+			previous->_next = node;
+		}
+		else {
+			_head = node;
+		}
+		if (current) {
+			current->_prev = node;
+		}
+		else {
+			_tail = node;
+		}
+	}
+	_size = total;
+	_note_reset();
 }
 
-template <typename ItemType>
-ItemType DList<ItemType>::pop(long position) {
+template <typename ItemType, typename Allocator>
+ItemType DList<ItemType, Allocator>::pop(long position) {
 	return _delete(position);
 }
 
-template <typename ItemType>
-void DList<ItemType>::remove(ItemType x) {
+template <typename ItemType, typename Allocator>
+size_t DList<ItemType, Allocator>::delete_many(const std::vector<long>& positions) {
+	auto before = _size;
+	_free_chain(_unlink_many(positions));
+	return static_cast<size_t>(before - _size);
+}
+
+template <typename ItemType, typename Allocator>
+std::vector<ItemType> DList<ItemType, Allocator>::pop_many(const std::vector<long>& positions) {
+	auto removed = _unlink_many(positions);
+	std::vector<ItemType> items;
+	for (auto node = removed; node != nullptr; node = node->_next) {
+		items.push_back(std::move(node->_item));
+	}
+	_free_chain(removed);
+	return items;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::remove(ItemType x) {
 	auto node = _head;
+	long index = 0;
 	while (node != nullptr) {
 		if (node->_item == x) {
-			auto previous = node->_prev.lock();
+			auto previous = node->_prev;
 			auto next = node->_next;
 			if (previous) {
 				previous->_next = next;
@@ -197,16 +980,19 @@ void DList<ItemType>::remove(ItemType x) {
 			else {
 				_tail = previous;
 			}
+			_delete_node(node);
 			--_size;
+			_note_erase(index, next);
 			return;
 		}
 		node = node->_next;
+		++index;
 	}
 }
 
-template <typename ItemType>
-size_t DList<ItemType>::index(ItemType x, size_t start) const {
-	auto node = _find(start);
+template <typename ItemType, typename Allocator>
+size_t DList<ItemType, Allocator>::index(ItemType x, size_t start) const {
+	auto node = _find_shared(start);
 	auto index = start;
 	while (node != nullptr) {
 		if (node->_item == x) {
@@ -218,8 +1004,8 @@ size_t DList<ItemType>::index(ItemType x, size_t start) const {
 	return -1;
 }
 
-template <typename ItemType>
-int DList<ItemType>::count(ItemType x) const {
+template <typename ItemType, typename Allocator>
+int DList<ItemType, Allocator>::count(ItemType x) const {
 	int count = 0;
 	auto node = _head;
 	while (node != nullptr) {
@@ -231,8 +1017,8 @@ int DList<ItemType>::count(ItemType x) const {
 	return count;
 }
 
-template <typename ItemType>
-void DList<ItemType>::extend(const DList& otherList) {
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::extend(const DList& otherList) {
 	if (&otherList == this) {
 		long n = _size;
 		auto node = _head;
@@ -251,49 +1037,550 @@ void DList<ItemType>::extend(const DList& otherList) {
 	}
 }
 
-template <typename ItemType>
-void DList<ItemType>::_copy(const DList& source) {
-	std::shared_ptr<DListNode<ItemType>> sourceNode, newNode;
-	sourceNode = source._head;
-	if (sourceNode) {
-		newNode = _head = std::make_shared<DListNode<ItemType>>(sourceNode->_item);
-		sourceNode = sourceNode->_next;
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::extend(DList&& otherList) {
+	if (&otherList == this) {
+		extend(static_cast<const DList&>(otherList));
+		return;
+	}
+	splice(_size, otherList, 0, LONG_MAX);
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::splice(long position, DList& other, long first, long last) {
+	if (position < 0) {
+		position += _size;
+	}
+	if (position < 0) {
+		position = 0;
+	}
+	if (position > _size) {
+		position = _size;
+	}
+	long count = other._slice_indices(first, last, 1);
+	if (count == 0) {
+		return;
+	}
+
+	if (!(_alloc == other._alloc)) {
+		// nodes cannot change hands; move the items into nodes of our own
+		_Node* chain = nullptr;
+		_Node* chainLast = nullptr;
+		auto node = other._seek(first);
+		try {
+			for (long i = 0; i < count; ++i, node = node->_next) {
+				auto newNode = _new_node(chainLast, nullptr, std::move(node->_item));
+				if (chainLast) {
+					chainLast->_next = newNode;
+				}
+				else {
+					chain = newNode;
+				}
+				chainLast = newNode;
+			}
+		}
+		catch (...) {
+			_free_chain(chain);
+			throw;
+		}
+		other.delete_slice(first, first + count);
+		_link_chain(position, chain, chainLast, count);
+		return;
+	}
+
+	if (&other == this) {
+		if (position >= first && position <= first + count) {
+			return;
+		}
+		if (position > first) {
+			position -= count;
+		}
+	}
+
+	// detach the range from other; each end is reached from its nearest starting point,
+	// so moving a whole list touches only its head and tail
+	auto rangeFirst = other._seek(first);
+	auto rangeLast = other._seek(first + count - 1);
+	auto before = rangeFirst->_prev;
+	auto after = rangeLast->_next;
+	if (before) {
+		before->_next = after;
 	}
 	else {
-		_head.reset();
+		other._head = after;
+	}
+	if (after) {
+		after->_prev = before;
 	}
-	while (sourceNode) {
-		newNode->_next = std::make_shared<DListNode<ItemType>>(sourceNode->_item, newNode);
-		newNode = newNode->_next;
-		sourceNode = sourceNode->_next;
+	else {
+		other._tail = before;
 	}
-	_tail = newNode;
+	other._size -= count;
+	other._note_reset();
+	other._allocations -= static_cast<unsigned long long>(count); // the nodes take their
+	_allocations += static_cast<unsigned long long>(count);       // allocations with them
+
+	_link_chain(position, rangeFirst, rangeLast, count);
+}
+
+template <typename ItemType, typename Allocator>
+DList<ItemType, Allocator> DList<ItemType, Allocator>::slice(long start, long stop, long step) const {
+	DList result(get_allocator());
+	if (step == 0) {
+		return result;
+	}
+	if (step < -LONG_MAX) {
+		step = -LONG_MAX; // same items, and -step stays representable
+	}
+	long count = _slice_indices(start, stop, step);
+	if (count == 0) {
+		return result;
+	}
+
+	result._reserve_nodes(static_cast<size_t>(count));
+	auto node = _seek_shared(start);
+	for (long i = 0; i < count; ++i) {
+		result.append(node->_item);
+		if (i + 1 == count) {
+			break;
+		}
+		if (step > 0) {
+			for (long s = 0; s < step; ++s) {
+				node = node->_next;
+			}
+		}
+		else {
+			for (long s = 0; s > step; --s) {
+				node = node->_prev;
+			}
+		}
+	}
+	return result;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::assign_slice(long start, long stop, long step, const DList& values) {
+	if (step == 0) {
+		return;
+	}
+	if (&values == this) {
+		// the items would change while they are being read
+		assign_slice(start, stop, step, DList(values));
+		return;
+	}
+	if (step < -LONG_MAX) {
+		step = -LONG_MAX;
+	}
+	long count = _slice_indices(start, stop, step);
+
+	if (step != 1) {
+		if (count != static_cast<long>(values._size) || count == 0) {
+			return;
+		}
+		auto node = _seek(start);
+		auto source = values._head;
+		for (long i = 0; i < count; ++i) {
+			node->_item = source->_item;
+			source = source->_next;
+			if (i + 1 == count) {
+				break;
+			}
+			for (long s = 0; s < step; ++s) {
+				node = node->_next;
+			}
+			for (long s = 0; s > step; --s) {
+				node = node->_prev;
+			}
+		}
+		return;
+	}
+
+	// copy first, so a throwing copy leaves the list as it was
+	_Node* newLast = nullptr;
+	auto newFirst = _copy_chain(values, newLast);
+	long added = static_cast<long>(values._size);
+
+	// detach the old range [start, start + count)
+	auto after = _find(start); // nullptr when start == _size
+	auto before = after != nullptr ? after->_prev : _tail;
+	auto oldFirst = after;
+	for (long i = 0; i < count; ++i) {
+		after = after->_next;
+	}
+	if (count > 0) {
+		(after != nullptr ? after->_prev : _tail)->_next = nullptr;
+	}
+
+	// link before -> new chain -> after
+	auto left = newFirst != nullptr ? newFirst : after;
+	auto right = newLast != nullptr ? newLast : before;
+	if (before) {
+		before->_next = left;
+	}
+	else {
+		_head = left;
+	}
+	if (after) {
+		after->_prev = right;
+	}
+	else {
+		_tail = right;
+	}
+	if (newFirst != nullptr) {
+		newFirst->_prev = before;
+		newLast->_next = after;
+	}
+
+	_size += added - count;
+	_note_reset();
+	if (count > 0) {
+		_free_chain(oldFirst);
+	}
+}
+
+template <typename ItemType, typename Allocator>
+size_t DList<ItemType, Allocator>::delete_slice(long start, long stop, long step) {
+	if (step == 0) {
+		return 0;
+	}
+	if (step < -LONG_MAX) {
+		step = -LONG_MAX;
+	}
+	long count = _slice_indices(start, stop, step);
+	if (count == 0) {
+		return 0;
+	}
+	if (step < 0) {
+		// the same positions, visited from the lowest
+		start += (count - 1) * step;
+		step = -step;
+	}
+	_free_chain(_unlink_stride(start, count, step));
+	return static_cast<size_t>(count);
+}
+
+template <typename ItemType, typename Allocator>
+std::vector<ItemType> DList<ItemType, Allocator>::get_many(const std::vector<long>& positions) const {
+	std::vector<ItemType> items(positions.size());
+	_CacheGuard guard(*this, false);
+	// in index order each seek walks forward from the node found by the previous one: the
+	// finger if this call owns it, and otherwise a local pointer
+	_Node* node = nullptr;
+	long index = 0;
+	for (const auto& entry : _sorted_positions(positions, positions.size())) {
+		if (guard.owns()) {
+			node = _seek(entry.first);
+		}
+		else if (node == nullptr || _size - 1 - entry.first < entry.first - index) {
+			node = _walk(entry.first);
+		}
+		else {
+			for (; index < entry.first; ++index) {
+				node = node->_next;
+			}
+		}
+		index = entry.first;
+		items[entry.second] = node->_item;
+	}
+	return items;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::set_many(const std::vector<long>& positions, const std::vector<ItemType>& values) {
+	auto count = positions.size() < values.size() ? positions.size() : values.size();
+	for (const auto& entry : _sorted_positions(positions, count)) {
+		_seek(entry.first)->_item = values[entry.second];
+	}
+}
+
+template <typename ItemType, typename Allocator>
+std::vector<std::pair<long, size_t>> DList<ItemType, Allocator>::_sorted_positions(const std::vector<long>& positions, size_t count) const {
+	std::vector<std::pair<long, size_t>> sorted;
+	sorted.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		long position = positions[i];
+		if (position < 0) {
+			position += _size;
+		}
+		if (position >= 0 && position < _size) {
+			sorted.emplace_back(position, i);
+		}
+	}
+	std::sort(sorted.begin(), sorted.end());
+	return sorted;
+}
+
+template <typename ItemType, typename Allocator>
+size_t DList<ItemType, Allocator>::_initial_cache_limit(const Allocator& alloc) {
+	if constexpr (std::is_same<Allocator, std::pmr::polymorphic_allocator<ItemType>>::value) {
+		if (dynamic_cast<DListSharedResource*>(alloc.resource()) != nullptr) {
+			return 0;
+		}
+	}
+	else {
+		(void)alloc;
+	}
+	return default_node_cache_limit;
+}
+
+template <typename ItemType, typename Allocator>
+bool DList<ItemType, Allocator>::_abandons_nodes() const {
+	if constexpr (std::is_trivially_destructible<ItemType>::value
+	              && std::is_same<Allocator, std::pmr::polymorphic_allocator<ItemType>>::value) {
+		auto shared = dynamic_cast<DListSharedResource*>(_alloc.resource());
+		return shared != nullptr && shared->release_only();
+	}
+	else {
+		return false;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_copy(const DList& source) {
+	// link the copy in only once every item has been copied, so a throwing copy
+	// leaves this list empty rather than half built
+	_Node* last;
+	_head = _copy_chain(source, last);
+	_tail = last;
+	_size = source._size;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_take(DList& source) noexcept {
+	_cache = source._cache;
+	_cacheSize = source._cacheSize;
+	_allocations = source._allocations;
+	_deallocations = source._deallocations;
+	_head = source._head;
+	_tail = source._tail;
 	_size = source._size;
+	_finger = source._finger;
+	_fingerIndex = source._fingerIndex;
+	_directory.swap(source._directory);
+	_directoryBias = source._directoryBias;
+	_directoryBlock = source._directoryBlock;
+	_directoryMutations = source._directoryMutations;
+	_directoryRebuilds = source._directoryRebuilds;
+	_directoryRebuildSteps = source._directoryRebuildSteps;
+
+	source._cache = nullptr;
+	source._cacheSize = 0;
+	source._allocations = 0;
+	source._deallocations = 0;
+	source._head = nullptr;
+	source._tail = nullptr;
+	source._size = 0;
+	source._directoryRebuilds = 0;
+	source._directoryRebuildSteps = 0;
+	source._note_reset();
 }
 
-template <typename ItemType>
-std::shared_ptr<DListNode<ItemType>> DList<ItemType>::_find(long position) const {
+template <typename ItemType, typename Allocator>
+typename DList<ItemType, Allocator>::_Node* DList<ItemType, Allocator>::_find(long position) const {
 	if (position >= _size || position < -_size) {
 		return nullptr;
 	}
-	if (position >= 0) {
-		auto current = _head;
-		for (long i = 0; i < position; i++) {
-			current = current->_next;
+	if (position < 0) {
+		position += _size;
+	}
+	return _seek(position);
+}
+
+template <typename ItemType, typename Allocator>
+typename DList<ItemType, Allocator>::_Node* DList<ItemType, Allocator>::_find_shared(long position) const {
+	if (position >= _size || position < -_size) {
+		return nullptr;
+	}
+	if (position < 0) {
+		position += _size;
+	}
+	return _seek_shared(position);
+}
+
+template <typename ItemType, typename Allocator>
+typename DList<ItemType, Allocator>::_Node* DList<ItemType, Allocator>::_seek_shared(long position) const {
+	_CacheGuard guard(*this, false);
+	return guard.owns() ? _seek(position) : _walk(position);
+}
+
+template <typename ItemType, typename Allocator>
+typename DList<ItemType, Allocator>::_Node* DList<ItemType, Allocator>::_seek(long position) const {
+	// start from the closest of _head, _tail and the finger
+	_Node* current = _head;
+	long index = 0;
+	if (_size - 1 - position < position) {
+		current = _tail;
+		index = _size - 1;
+	}
+	long distance = position > index ? position - index : index - position;
+	if (_finger != nullptr) {
+		long fromFinger = position > _fingerIndex ? position - _fingerIndex : _fingerIndex - position;
+		if (fromFinger < distance) {
+			current = _finger;
+			index = _fingerIndex;
+			distance = fromFinger;
 		}
-		return current;
 	}
-	else {
+
+	// a long walk is worth (re)building the directory and starting from its nearest entry
+	if (_size >= directory_min_length && distance > _directory_block()) {
+		if (_directory.empty()) {
+			_build_directory();
+		}
+		auto k = _directory_lower_bound(position);
+		for (auto i = k > 0 ? k - 1 : k; i <= k && i < _directory.size(); ++i) {
+			long entryIndex = _directory[i]._position + _directoryBias;
+			long fromEntry = position > entryIndex ? position - entryIndex : entryIndex - position;
+			if (fromEntry < distance) {
+				current = _directory[i]._node;
+				index = entryIndex;
+				distance = fromEntry;
+			}
+		}
+	}
+
+	while (index < position) {
+		current = current->_next;
+		++index;
+	}
+	while (index > position) {
+		current = current->_prev;
+		--index;
+	}
+	_finger = current;
+	_fingerIndex = position;
+	return current;
+}
+
+template <typename ItemType, typename Allocator>
+typename DList<ItemType, Allocator>::_Node* DList<ItemType, Allocator>::_walk(long position) const {
+	if (_size - 1 - position < position) {
 		auto current = _tail;
-		for (long i = -1; i > position; i--) {
-			current = current->_prev.lock();
+		for (long index = _size - 1; index > position; --index) {
+			current = current->_prev;
 		}
 		return current;
 	}
+	auto current = _head;
+	for (long index = 0; index < position; ++index) {
+		current = current->_next;
+	}
+	return current;
+}
+
+template <typename ItemType, typename Allocator>
+long DList<ItemType, Allocator>::_directory_block() const {
+	auto block = static_cast<long>(std::sqrt(static_cast<double>(_size)));
+	return block < 1 ? 1 : block;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_build_directory() const {
+	_directory.clear();
+	_directoryBias = 0;
+	_directoryBlock = _directory_block();
+	_directoryMutations = 0;
+	_directory.reserve(static_cast<size_t>(_size / _directoryBlock + 1));
+
+	long untilEntry = 0;
+	long index = 0;
+	for (auto node = _head; node != nullptr; node = node->_next) {
+		if (untilEntry == 0) {
+			_directory.push_back(_DirEntry{node, index});
+			untilEntry = _directoryBlock;
+		}
+		--untilEntry;
+		++index;
+	}
+	++_directoryRebuilds;
+	_directoryRebuildSteps += static_cast<unsigned long long>(_size);
+}
+
+template <typename ItemType, typename Allocator>
+size_t DList<ItemType, Allocator>::_directory_lower_bound(long position) const {
+	long bias = _directoryBias;
+	auto entry = std::lower_bound(_directory.begin(), _directory.end(), position,
+		[bias](const _DirEntry& e, long p) { return e._position + bias < p; });
+	return static_cast<size_t>(entry - _directory.begin());
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_directory_shift(size_t first, long delta) {
+	if (first < _directory.size() - first) {
+		// shifting everything through the bias and undoing it below first is cheaper
+		_directoryBias += delta;
+		for (size_t i = 0; i < first; ++i) {
+			_directory[i]._position -= delta;
+		}
+	}
+	else {
+		for (size_t i = first; i < _directory.size(); ++i) {
+			_directory[i]._position += delta;
+		}
+	}
+}
+
+template <typename ItemType, typename Allocator>
+bool DList<ItemType, Allocator>::_directory_mutated() {
+	if (_directory.empty()) {
+		return false;
+	}
+	if (++_directoryMutations > _directoryBlock) {
+		_directory.clear(); // blocks may have drifted to twice their size; rebuild lazily
+		return false;
+	}
+	return true;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_note_insert(long position) {
+	if (_finger != nullptr && _fingerIndex >= position) {
+		++_fingerIndex;
+	}
+	if (!_directory_mutated()) {
+		return;
+	}
+	if (_directory.back()._position + _directoryBias < position) {
+		return; // appended past the last entry
+	}
+	_directory_shift(_directory_lower_bound(position), 1);
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_note_erase(long position, _Node* next) {
+	if (_finger != nullptr && _fingerIndex >= position) {
+		if (_fingerIndex == position) {
+			_finger = next; // the next node now has the removed node's index
+		}
+		else {
+			--_fingerIndex;
+		}
+	}
+	if (!_directory_mutated()) {
+		return;
+	}
+
+	// entries on the removed node move to the next one, which takes over its index
+	auto k = _directory_lower_bound(position);
+	while (k < _directory.size() && _directory[k]._position + _directoryBias == position) {
+		if (next == nullptr) {
+			_directory.erase(_directory.begin() + static_cast<long>(k), _directory.end());
+			return;
+		}
+		_directory[k]._node = next;
+		++k;
+	}
+	_directory_shift(k, -1);
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_note_reset() {
+	_finger = nullptr;
+	_directory.clear();
 }
 
-template <typename ItemType>
-ItemType DList<ItemType>::_delete(long position) {
+template <typename ItemType, typename Allocator>
+ItemType DList<ItemType, Allocator>::_delete(long position) {
 	// normalize negative indices
 	if (position < 0) position += _size;
 
@@ -302,8 +1589,8 @@ ItemType DList<ItemType>::_delete(long position) {
 		return ItemType{};
 	}
 
-	auto current = _find(position);        // guaranteed non-null now
-	auto previous = current->_prev.lock();
+	auto current = _seek(position);
+	auto previous = current->_prev;
 	auto next = current->_next;
 
 	if (previous) {
@@ -320,7 +1607,336 @@ ItemType DList<ItemType>::_delete(long position) {
 	}
 
 	--_size;
-	return current->_item;
+	_note_erase(position, next);
+	ItemType item = std::move(current->_item);
+	_delete_node(current);
+	return item;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::set_node_cache_limit(size_t limit) {
+	_cacheLimit = limit;
+	while (_cacheSize > _cacheLimit) {
+		auto cached = _cache;
+		_cache = cached->_next;
+		--_cacheSize;
+		_NodeTraits::deallocate(_alloc, reinterpret_cast<_Node*>(cached), 1);
+		++_deallocations;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::shrink_to_fit() {
+	auto limit = _cacheLimit;
+	set_node_cache_limit(0);
+	_cacheLimit = limit;
+}
+
+template <typename ItemType, typename Allocator>
+DListStats DList<ItemType, Allocator>::stats() const {
+	_CacheGuard guard(*this, true);
+	DListStats stats;
+	stats.bytes_used = _bytes_used();
+	stats.payload_bytes = static_cast<size_t>(_size) * sizeof(ItemType);
+	stats.structural_bytes = stats.bytes_used - stats.payload_bytes;
+	stats.live_nodes = static_cast<size_t>(_size);
+	stats.cached_nodes = _cacheSize;
+	stats.allocations = _allocations;
+	stats.deallocations = _deallocations;
+	stats.directory_entries = _directory.size();
+	stats.directory_rebuilds = _directoryRebuilds;
+	stats.directory_rebuild_steps = _directoryRebuildSteps;
+	return stats;
+}
+
+template <typename ItemType, typename Allocator>
+long DList<ItemType, Allocator>::_slice_indices(long& start, long& stop, long step) const {
+	for (long* bound : {&start, &stop}) {
+		if (*bound < 0) {
+			*bound += _size;
+			if (*bound < 0) {
+				*bound = step < 0 ? -1 : 0;
+			}
+		}
+		else if (*bound >= _size) {
+			*bound = step < 0 ? _size - 1 : _size;
+		}
+	}
+	if (step < 0) {
+		return stop < start ? (start - stop - 1) / -step + 1 : 0;
+	}
+	return start < stop ? (stop - start - 1) / step + 1 : 0;
+}
+
+template <typename ItemType, typename Allocator>
+typename DList<ItemType, Allocator>::_Node* DList<ItemType, Allocator>::_copy_chain(const DList& source, _Node*& last) {
+	_Node* first = nullptr;
+	last = nullptr;
+	try {
+		for (auto node = source._head; node != nullptr; node = node->_next) {
+			auto newNode = _new_node(last, nullptr, node->_item);
+			if (last) {
+				last->_next = newNode;
+			}
+			else {
+				first = newNode;
+			}
+			last = newNode;
+		}
+	}
+	catch (...) {
+		_free_chain(first);
+		throw;
+	}
+	return first;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_link_chain(long position, _Node* first, _Node* last, long count) {
+	auto after = position < _size ? _seek(position) : nullptr;
+	auto before = after != nullptr ? after->_prev : _tail;
+	first->_prev = before;
+	last->_next = after;
+	if (before) {
+		before->_next = first;
+	}
+	else {
+		_head = first;
+	}
+	if (after) {
+		after->_prev = last;
+	}
+	else {
+		_tail = last;
+	}
+	_size += count;
+	_note_reset();
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_detach(_Node* node, _Node*& chain, _Node*& chainTail) {
+	auto previous = node->_prev;
+	auto next = node->_next;
+	if (previous) {
+		previous->_next = next;
+	}
+	else {
+		_head = next;
+	}
+	if (next) {
+		next->_prev = previous;
+	}
+	else {
+		_tail = previous;
+	}
+
+	node->_prev = chainTail;
+	node->_next = nullptr;
+	if (chainTail) {
+		chainTail->_next = node;
+	}
+	else {
+		chain = node;
+	}
+	chainTail = node;
+}
+
+template <typename ItemType, typename Allocator>
+typename DList<ItemType, Allocator>::_Node* DList<ItemType, Allocator>::_unlink_stride(long first, long count, long step) {
+	_Node* removed = nullptr;
+	_Node* removedTail = nullptr;
+	auto current = _seek(first);
+	for (long i = 0; i < count; ++i) {
+		auto next = current->_next;
+		_detach(current, removed, removedTail);
+
+		current = next;
+		for (long s = 1; s < step && i + 1 < count; ++s) {
+			current = current->_next;
+		}
+	}
+	_size -= count;
+	_note_reset();
+	return removed;
+}
+
+template <typename ItemType, typename Allocator>
+typename DList<ItemType, Allocator>::_Node* DList<ItemType, Allocator>::_unlink_many(const std::vector<long>& positions) {
+	auto sorted = _sorted_positions(positions, positions.size());
+	if (sorted.empty()) {
+		return nullptr;
+	}
+
+	_Node* removed = nullptr;
+	_Node* removedTail = nullptr;
+	long index = sorted[0].first;
+	auto current = _seek(index);
+	for (size_t i = 0; i < sorted.size(); ++i) {
+		if (i > 0 && sorted[i].first == sorted[i - 1].first) {
+			continue;
+		}
+		while (index < sorted[i].first) {
+			current = current->_next;
+			++index;
+		}
+
+		auto next = current->_next;
+		_detach(current, removed, removedTail);
+		--_size;
+
+		// next holds the old index after the removed one
+		current = next;
+		++index;
+	}
+	_note_reset();
+	return removed;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_free_chain(_Node* first) {
+	while (first != nullptr) {
+		auto next = first->_next;
+		_delete_node(first);
+		first = next;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+template <typename... Args>
+typename DList<ItemType, Allocator>::_Node* DList<ItemType, Allocator>::_new_node(_Node* prev, _Node* next, Args&&... args) {
+	_Node* node;
+	if (_cache != nullptr) {
+		auto cached = _cache;
+		_cache = cached->_next;
+		--_cacheSize;
+		node = reinterpret_cast<_Node*>(cached);
+	}
+	else {
+		node = _NodeTraits::allocate(_alloc, 1);
+		++_allocations;
+	}
+	try {
+		_NodeTraits::construct(_alloc, node, prev, next, std::forward<Args>(args)...);
+	}
+	catch (...) {
+		_NodeTraits::deallocate(_alloc, node, 1);
+		++_deallocations;
+		throw;
+	}
+	return node;
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_delete_node(_Node* node) {
+	_NodeTraits::destroy(_alloc, node);
+	if (_cacheSize < _cacheLimit) {
+		_cache = ::new (static_cast<void*>(node)) _CachedNode{_cache};
+		++_cacheSize;
+	}
+	else {
+		_NodeTraits::deallocate(_alloc, node, 1);
+		++_deallocations;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+void DList<ItemType, Allocator>::_reserve_nodes(size_t count) {
+	try {
+		while (_cacheSize < count) {
+			auto node = _NodeTraits::allocate(_alloc, 1);
+			++_allocations;
+			_cache = ::new (static_cast<void*>(node)) _CachedNode{_cache};
+			++_cacheSize;
+		}
+	}
+	catch (...) {
+		set_node_cache_limit(_cacheLimit);
+		throw;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+class DList<ItemType, Allocator>::node_type {
+
+public:
+    using value_type = ItemType;
+    using allocator_type = Allocator;
+
+    /// constructor; creates an empty handle
+    node_type() noexcept : _node(nullptr) {}
+
+    /// move constructor; takes the node of source and leaves source empty
+    node_type(node_type&& source) noexcept : _node(source._node), _alloc(std::move(source._alloc)) {
+        source._node = nullptr;
+        source._alloc.reset();
+    }
+
+    /// move assignment operator; frees the node held so far, then takes the node of
+    /// source and leaves source empty
+    node_type& operator=(node_type&& source) noexcept {
+        if (this != &source) {
+            _free();
+            _node = source._node;
+            _alloc.reset();
+            if (source._alloc) {
+                _alloc.emplace(std::move(*source._alloc));
+            }
+            source._node = nullptr;
+            source._alloc.reset();
+        }
+        return *this;
+    }
+
+    node_type(const node_type&) = delete;
+    node_type& operator=(const node_type&) = delete;
+
+    /// destructor; destroys the item and returns the node to its allocator
+    ~node_type() { _free(); }
+
+    /// returns true if the handle holds no node
+    bool empty() const noexcept { return _node == nullptr; }
+
+    /// returns true if the handle holds a node
+    explicit operator bool() const noexcept { return _node != nullptr; }
+
+    /// reference to the item in the node; the handle must not be empty
+    ItemType& value() const { return _node->_item; }
+
+    /// returns a copy of the allocator the node came from; the handle must not be empty
+    allocator_type get_allocator() const { return allocator_type(*_alloc); }
+
+private:
+    friend class DList;
+
+    node_type(_Node* node, const _NodeAllocator& alloc) : _node(node), _alloc(alloc) {}
+
+    // destroys and deallocates the node, if any; extract already took the node's
+    // allocation off its list's count, so neither count changes here
+    void _free() noexcept {
+        if (_node != nullptr) {
+            _NodeTraits::destroy(*_alloc, _node);
+            _NodeTraits::deallocate(*_alloc, _node, 1);
+            _node = nullptr;
+        }
+    }
+
+    // the detached node and the allocator it must be returned to; the allocator is
+    // engaged exactly when there is a node, since it need not be default-constructible
+    _Node* _node;
+    std::optional<_NodeAllocator> _alloc;
+};
+
+/// exchanges the contents of two lists, as DList::swap does
+template <typename ItemType, typename Allocator>
+void swap(DList<ItemType, Allocator>& a, DList<ItemType, Allocator>& b) noexcept {
+	a.swap(b);
+}
+
+namespace pmr {
+    /// DList whose nodes come from a std::pmr::memory_resource, e.g.
+    /// std::pmr::monotonic_buffer_resource for request-scoped lists
+    template <typename ItemType>
+    using DList = ::DList<ItemType, std::pmr::polymorphic_allocator<ItemType>>;
 }
 
 #endif /* DList_hpp */
\ No newline at end of file
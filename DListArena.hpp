@@ -0,0 +1,237 @@
+// DListArena.hpp
+#ifndef DListArena_hpp
+#define DListArena_hpp
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include "DList.hpp"
+
+/// memory resource that many pmr::DList objects can share: small blocks (nodes) are
+/// carved from large slabs and recycled through per-size free lists, larger blocks are
+/// passed to the upstream resource; release() and the destructor return everything to
+/// upstream in O(slabs + large blocks) without visiting individual nodes, so every list
+/// built on the arena must be destroyed or cleared before then; requests aligned beyond
+/// std::max_align_t are forwarded to upstream as they are and not tracked
+///
+/// as a DListSharedResource, pmr::DList objects built on the arena keep no node cache of
+/// their own, so a node one list frees is available to every other list at once; a
+/// list that raises its limit with set_node_cache_limit() keeps its cached nodes to
+/// itself until it is cleared down or destroyed
+///
+/// in release-only mode (set_release_only(true)) a pmr::DList of trivially destructible
+/// items returns nothing when it is destroyed, so tearing down lists and arena together
+/// costs O(slabs + large blocks) rather than a walk over every node; the nodes of such
+/// lists are not reused until release()
+///
+///     DListArena arena;
+///     pmr::DList<std::string> a(&arena), b(&arena);
+class DListArena : public DListSharedResource {
+
+public:
+    /// default size in bytes of each slab requested from upstream
+    static constexpr size_t default_slab_size = 64 * 1024;
+
+    /// largest block served from slabs; larger requests go to upstream
+    static constexpr size_t max_small_size = 512;
+
+    /// constructor
+    /// @param slabSize bytes requested from upstream for each slab
+    /// @param upstream resource the slabs are obtained from
+    explicit DListArena(size_t slabSize = default_slab_size,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    DListArena(const DListArena&) = delete;
+    DListArena& operator=(const DListArena&) = delete;
+
+    /// destructor; releases all memory
+    ~DListArena() override;
+
+    /// returns every slab and large block to upstream; all blocks handed out become invalid
+    void release();
+
+    /// turns release-only mode on or off; the mode applies to lists at the time they are
+    /// destroyed
+    /// @param on true to let lists of trivially destructible items skip freeing their nodes
+    void set_release_only(bool on) { _releaseOnly = on; }
+
+    /// returns the number of slabs currently held
+    size_t slab_count() const { return _slabCount; }
+
+    /// returns the bytes currently held from upstream (slabs and large blocks)
+    size_t bytes_reserved() const { return _bytesReserved; }
+
+    /// returns the resource slabs are obtained from
+    std::pmr::memory_resource* upstream_resource() const { return _upstream; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    // every small block is a multiple of this size and aligned to it
+    static constexpr size_t _granule = alignof(std::max_align_t);
+    static constexpr size_t _classCount = max_small_size / _granule;
+
+    // free small block, chained through its first bytes
+    struct _FreeBlock {
+        _FreeBlock* _next;
+    };
+
+    // header at the start of each slab and of each large block
+    struct alignas(std::max_align_t) _Header {
+        _Header* _next;
+        _Header* _prev;
+        size_t _bytes;
+    };
+
+    /// returns the size-class index for a small request
+    /// @param bytes requested size, at most max_small_size
+    static size_t _class_of(size_t bytes) { return (bytes + _granule - 1) / _granule - 1; }
+
+    /// gets a block from upstream with a header, links it into list and returns the header
+    /// @param list head of the list to link the block into
+    /// @param bytes usable bytes needed after the header
+    _Header* _upstream_block(_Header*& list, size_t bytes);
+
+    /// unlinks a block from list and returns it to upstream
+    /// @param list head of the list the block is linked into
+    /// @param block header of the block to return
+    void _release_block(_Header*& list, _Header* block);
+
+    // resource slabs and large blocks are obtained from
+    std::pmr::memory_resource* _upstream;
+
+    // bytes requested for each slab
+    size_t _slabSize;
+
+    // slabs and large blocks currently held
+    _Header* _slabs;
+    _Header* _large;
+    size_t _slabCount;
+    size_t _bytesReserved;
+
+    // unused tail of the newest slab
+    char* _cursor;
+    char* _end;
+
+    // recycled small blocks by size class
+    _FreeBlock* _free[_classCount];
+};
+
+
+inline DListArena::DListArena(size_t slabSize, std::pmr::memory_resource* upstream) {
+	_upstream = upstream;
+	_slabSize = slabSize < 2 * max_small_size ? 2 * max_small_size : slabSize;
+	_slabs = nullptr;
+	_large = nullptr;
+	_slabCount = 0;
+	_bytesReserved = 0;
+	_cursor = nullptr;
+	_end = nullptr;
+	for (auto& list : _free) {
+		list = nullptr;
+	}
+}
+
+inline DListArena::~DListArena() {
+	release();
+}
+
+inline void DListArena::release() {
+	while (_slabs != nullptr) {
+		_release_block(_slabs, _slabs);
+	}
+	while (_large != nullptr) {
+		_release_block(_large, _large);
+	}
+	_slabCount = 0;
+	_cursor = nullptr;
+	_end = nullptr;
+	for (auto& list : _free) {
+		list = nullptr;
+	}
+}
+
+inline void* DListArena::do_allocate(size_t bytes, size_t alignment) {
+	if (alignment > _granule) {
+		return _upstream->allocate(bytes, alignment);
+	}
+	if (bytes > max_small_size) {
+		auto block = _upstream_block(_large, bytes);
+		return block + 1;
+	}
+	if (bytes == 0) {
+		bytes = 1;
+	}
+
+	auto cls = _class_of(bytes);
+	if (_free[cls] != nullptr) {
+		auto block = _free[cls];
+		_free[cls] = block->_next;
+		return block;
+	}
+
+	size_t size = (cls + 1) * _granule;
+	if (static_cast<size_t>(_end - _cursor) < size) {
+		// the unused tail of the old slab is abandoned until release()
+		auto slab = _upstream_block(_slabs, _slabSize - sizeof(_Header));
+		++_slabCount;
+		_cursor = reinterpret_cast<char*>(slab + 1);
+		_end = _cursor + (_slabSize - sizeof(_Header));
+	}
+	void* p = _cursor;
+	_cursor += size;
+	return p;
+}
+
+inline void DListArena::do_deallocate(void* p, size_t bytes, size_t alignment) {
+	if (alignment > _granule) {
+		_upstream->deallocate(p, bytes, alignment);
+		return;
+	}
+	if (bytes > max_small_size) {
+		_release_block(_large, static_cast<_Header*>(p) - 1);
+		return;
+	}
+	if (bytes == 0) {
+		bytes = 1;
+	}
+	auto cls = _class_of(bytes);
+	_free[cls] = ::new (p) _FreeBlock{_free[cls]};
+}
+
+inline bool DListArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
+
+inline DListArena::_Header* DListArena::_upstream_block(_Header*& list, size_t bytes) {
+	size_t total = sizeof(_Header) + bytes;
+	auto block = static_cast<_Header*>(_upstream->allocate(total, alignof(_Header)));
+	block->_bytes = total;
+	block->_prev = nullptr;
+	block->_next = list;
+	if (list != nullptr) {
+		list->_prev = block;
+	}
+	list = block;
+	_bytesReserved += total;
+	return block;
+}
+
+inline void DListArena::_release_block(_Header*& list, _Header* block) {
+	if (block->_prev != nullptr) {
+		block->_prev->_next = block->_next;
+	}
+	else {
+		list = block->_next;
+	}
+	if (block->_next != nullptr) {
+		block->_next->_prev = block->_prev;
+	}
+	_bytesReserved -= block->_bytes;
+	_upstream->deallocate(block, block->_bytes, alignof(_Header));
+}
+
+#endif /* DListArena_hpp */
@@ -3,20 +3,28 @@
 #ifndef DListNode_h
 #define DListNode_h
 
+#include <utility>
+
 #ifdef DEBUG
 #include <iostream>
 #endif
 
-#include <memory>
-
 // typedef int ItemType;
 
+/// node of a DList; the links are plain pointers owned and managed by the DList
+/// that holds the node, so a node carries no reference counts of its own
 template<typename ItemType>
 class DListNode {
-    template <typename> friend class DList;
+    template <typename, typename> friend class DList;
 
 public:
-    DListNode(ItemType item, std::shared_ptr<DListNode> prev = nullptr, std::shared_ptr<DListNode> next = nullptr);
+    /// constructs the item in place from args, so ItemType needs no default constructor
+    /// and an rvalue argument is moved rather than copied
+    /// @param prev node before this node
+    /// @param next node after this node
+    /// @param args arguments forwarded to ItemType's constructor
+    template <typename... Args>
+    DListNode(DListNode* prev, DListNode* next, Args&&... args);
 
 #ifdef DEBUG
     // ~DListNode() { std::cerr << "deallocate DListNode " << _item << std::endl; }
@@ -24,14 +32,13 @@ public:
 
 private:
     ItemType _item;
-    std::shared_ptr<DListNode> _next;
-    std::weak_ptr<DListNode> _prev;
+    DListNode* _next;
+    DListNode* _prev;
 };
 template<typename ItemType>
-inline DListNode<ItemType>::DListNode(ItemType item, std::shared_ptr<DListNode> prev, std::shared_ptr<DListNode> next) {
-    _item = item;
-    _prev = prev;
-    _next = next;
+template <typename... Args>
+inline DListNode<ItemType>::DListNode(DListNode* prev, DListNode* next, Args&&... args)
+    : _item(std::forward<Args>(args)...), _next(next), _prev(prev) {
 }
 
-#endif /* DListNode_h */
\ No newline at end of file
+#endif /* DListNode_h */
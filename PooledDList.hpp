@@ -0,0 +1,474 @@
+// PooledDList.hpp
+#ifndef PooledDList_hpp
+#define PooledDList_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// doubly linked list with the same interface as DList whose nodes live in one
+/// contiguous, growable pool and link to each other with 32-bit indices; a node is
+/// the payload plus 8 bytes, and for trivially copyable ItemType the pool is grown
+/// and copied with memcpy; a list holds at most 2^32 - 1 nodes, and adding one more
+/// throws std::length_error
+template <typename ItemType, typename Allocator = std::allocator<ItemType>>
+class PooledDList {
+
+public:
+    using allocator_type = Allocator;
+
+    /// constructor
+    PooledDList();
+
+    /// constructor that obtains the pool from alloc
+    /// @param alloc allocator to use for this list's pool
+    explicit PooledDList(const Allocator& alloc);
+
+    /// copy constructor
+    PooledDList(const PooledDList& source);
+
+    /// destructor
+    ~PooledDList();
+
+    /// assignment operator
+    PooledDList& operator=(const PooledDList& source);
+
+    /// returns the number of items in the list
+    size_t length() const { return _size; }
+
+    /// returns the number of nodes the pool can hold without growing
+    size_t capacity() const { return _capacity; }
+
+    /// grows the pool so it can hold at least n nodes
+    /// @param n number of nodes to make room for
+    void reserve(size_t n);
+
+    /// item at index specified by position
+    /// @param position index of item to return
+    /// @return item at index specified by position
+    ItemType operator[](long position) const;
+
+    /// reference to item at index specified by position; it is invalidated when the pool grows
+    /// @param position index of item to return
+    /// @return reference to item at index specified by position
+    ItemType& operator[](long position);
+
+    /// removes all elements from the list; the pool keeps its capacity
+    void clear();
+
+    /// adds the value x onto the end of the list
+    /// @param x value to add to the end of the list
+    void append(const ItemType& x);
+
+    /// inserts x at the index (negative or non-negative) at the specified position; note if
+    /// position is beyond the end, it adds to the end of the list or if position is beyond
+    /// the beginning it inserts at the beginning
+    /// @param position index to insert at
+    /// @param x value to insert at specified position
+    void insert(long position, const ItemType& x);
+
+    /// remove and return element at index specified by position
+    /// @param position index of element to remove
+    ItemType pop(long position = -1);
+
+    /// removes element from the list
+    /// @param x element to remove
+    void remove(ItemType x);
+
+    /// returns non-negative index of x starting at index start
+    /// @param x value to find the index of
+    /// @return non-negative index of x or -1 if not found
+    size_t index(ItemType x, size_t start = 0) const;
+
+    /// returns number of copies of x in the list
+    /// @param x value to count
+    /// @return number of copies of x in the list
+    int count(ItemType x) const;
+
+    /// adds each element of otherList onto this list
+    /// @param otherList list to add the elements of
+    void extend(const PooledDList& otherList);
+
+    /// returns a copy of the allocator used by this list
+    allocator_type get_allocator() const { return allocator_type(_alloc); }
+
+    /// returns the bytes of the list object plus all storage it holds from its allocator;
+    /// heap memory owned by the items is not counted
+    size_t bytes_used() const { return sizeof(PooledDList) + _capacity * sizeof(_Node); }
+
+private:
+    // link value meaning "no node"
+    static constexpr uint32_t _npos = UINT32_MAX;
+
+    // pool slot; _storage holds a constructed item only while the slot is linked into the
+    // list, free slots are chained through _next
+    struct _Node {
+        alignas(ItemType) unsigned char _storage[sizeof(ItemType)];
+        uint32_t _next;
+        uint32_t _prev;
+    };
+    using _NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_Node>;
+    using _NodeTraits = std::allocator_traits<_NodeAllocator>;
+
+    // true if the pool can be relocated by copying its bytes
+    static constexpr bool _relocatable = std::is_trivially_copyable<ItemType>::value;
+
+    ItemType& _item(uint32_t i) { return *reinterpret_cast<ItemType*>(_pool[i]._storage); }
+    const ItemType& _item(uint32_t i) const { return *reinterpret_cast<const ItemType*>(_pool[i]._storage); }
+
+    /// helper function for copy constructor and operator=
+    /// @param source existing list to copy the items of into this (empty) list
+    void _copy(const PooledDList& source);
+
+    /// returns slot of the node at specified index
+    /// @param position index from -length() to length()
+    /// @return slot of the node at specified position or _npos if position is out of range
+    uint32_t _find(long position) const;
+
+    /// takes a free slot (growing the pool if needed) and constructs x in it; throws
+    /// std::length_error if every slot index is in use
+    /// @param x value to store; may refer to an item in the pool
+    /// @return slot of the new node, not yet linked into the list
+    uint32_t _new_node(const ItemType& x);
+
+    /// moves the pool to a new allocation of newCapacity slots
+    /// @param newCapacity number of slots of the new pool
+    void _relocate(size_t newCapacity);
+
+    /// unlinks the node in slot i, destroys its item and puts the slot on the free chain
+    /// @param i slot of the node to remove
+    /// @return the removed item
+    ItemType _erase(uint32_t i);
+
+    /// remove and return the element at the specified index
+    /// if index is invalid, it does nothing
+    /// @param position index of element to remove
+    ItemType _delete(long position);
+
+    // allocator the pool is obtained from
+    _NodeAllocator _alloc;
+
+    // the pool, its capacity and the number of slots ever handed out
+    _Node* _pool;
+    size_t _capacity;
+    size_t _used;
+
+    // first slot of the chain of free slots below _used
+    uint32_t _free;
+
+    // slots of the head, and tail nodes
+    uint32_t _head, _tail;
+
+    // number of items in the list
+    long _size;
+};
+
+
+template <typename ItemType, typename Allocator>
+PooledDList<ItemType, Allocator>::PooledDList() : PooledDList(Allocator()) {
+}
+
+template <typename ItemType, typename Allocator>
+PooledDList<ItemType, Allocator>::PooledDList(const Allocator& alloc) : _alloc(alloc) {
+	_pool = nullptr;
+	_capacity = 0;
+	_used = 0;
+	_free = _npos;
+	_head = _npos;
+	_tail = _npos;
+	_size = 0;
+}
+
+template <typename ItemType, typename Allocator>
+PooledDList<ItemType, Allocator>::PooledDList(const PooledDList& source)
+	: PooledDList(Allocator(_NodeTraits::select_on_container_copy_construction(source._alloc))) {
+	_copy(source);
+}
+
+template <typename ItemType, typename Allocator>
+PooledDList<ItemType, Allocator>::~PooledDList() {
+	clear();
+	if (_pool) {
+		_NodeTraits::deallocate(_alloc, _pool, _capacity);
+	}
+}
+
+template <typename ItemType, typename Allocator>
+PooledDList<ItemType, Allocator>& PooledDList<ItemType, Allocator>::operator=(const PooledDList& source) {
+	if (this != &source) {
+		clear();
+		if constexpr (_NodeTraits::propagate_on_container_copy_assignment::value) {
+			if (_pool) {
+				_NodeTraits::deallocate(_alloc, _pool, _capacity);
+				_pool = nullptr;
+				_capacity = 0;
+			}
+			_alloc = source._alloc;
+		}
+		_copy(source);
+	}
+	return *this;
+}
+
+template <typename ItemType, typename Allocator>
+void PooledDList<ItemType, Allocator>::reserve(size_t n) {
+	if (n > _capacity) {
+		_relocate(n);
+	}
+}
+
+template <typename ItemType, typename Allocator>
+ItemType PooledDList<ItemType, Allocator>::operator[](long position) const {
+	return _item(_find(position));
+}
+
+template <typename ItemType, typename Allocator>
+ItemType& PooledDList<ItemType, Allocator>::operator[](long position) {
+	return _item(_find(position));
+}
+
+template <typename ItemType, typename Allocator>
+void PooledDList<ItemType, Allocator>::clear() {
+	if (!std::is_trivially_destructible<ItemType>::value) {
+		for (auto i = _head; i != _npos; i = _pool[i]._next) {
+			std::destroy_at(&_item(i));
+		}
+	}
+	_used = 0;
+	_free = _npos;
+	_head = _npos;
+	_tail = _npos;
+	_size = 0;
+}
+
+template <typename ItemType, typename Allocator>
+void PooledDList<ItemType, Allocator>::append(const ItemType& x) {
+	auto i = _new_node(x);
+	_pool[i]._prev = _tail;
+	_pool[i]._next = _npos;
+	if (_size == 0) {
+		_head = i;
+	}
+	else {
+		_pool[_tail]._next = i;
+	}
+	_tail = i;
+	_size++;
+}
+
+template <typename ItemType, typename Allocator>
+void PooledDList<ItemType, Allocator>::insert(long position, const ItemType& x) {
+
+	if (position < 0) { // convert negative position to positive to insert at index
+		position += _size;
+	}
+	if (position < 0) { // if still negative, set to 0 so we can insert at front
+		position = 0;
+	}
+	if (position > _size) { // if beyond end, set to end so we can append
+		position = _size;
+	}
+
+	if (_size == 0 || position == _size) {
+		append(x);
+		return;
+	}
+
+	auto i = _new_node(x); // may relocate the pool, so look up the position afterwards
+	auto current = _find(position);
+	auto previous = _pool[current]._prev;
+	_pool[i]._prev = previous;
+	_pool[i]._next = current;
+	if (previous != _npos) {
+		_pool[previous]._next = i;
+	}
+	else {
+		_head = i;
+	}
+	_pool[current]._prev = i;
+	++_size;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType PooledDList<ItemType, Allocator>::pop(long position) {
+	return _delete(position);
+}
+
+template <typename ItemType, typename Allocator>
+void PooledDList<ItemType, Allocator>::remove(ItemType x) {
+	for (auto i = _head; i != _npos; i = _pool[i]._next) {
+		if (_item(i) == x) {
+			_erase(i);
+			return;
+		}
+	}
+}
+
+template <typename ItemType, typename Allocator>
+size_t PooledDList<ItemType, Allocator>::index(ItemType x, size_t start) const {
+	auto i = _find(static_cast<long>(start));
+	auto index = start;
+	while (i != _npos) {
+		if (_item(i) == x) {
+			return index;
+		}
+		i = _pool[i]._next;
+		++index;
+	}
+	return -1;
+}
+
+template <typename ItemType, typename Allocator>
+int PooledDList<ItemType, Allocator>::count(ItemType x) const {
+	int count = 0;
+	for (auto i = _head; i != _npos; i = _pool[i]._next) {
+		if (_item(i) == x) {
+			++count;
+		}
+	}
+	return count;
+}
+
+template <typename ItemType, typename Allocator>
+void PooledDList<ItemType, Allocator>::extend(const PooledDList& otherList) {
+	// for self-extension only the items present at the start are appended
+	long n = otherList._size;
+	auto i = otherList._head;
+	for (long k = 0; k < n; ++k) {
+		append(otherList._item(i));
+		i = otherList._pool[i]._next;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+void PooledDList<ItemType, Allocator>::_copy(const PooledDList& source) {
+	if (_relocatable) {
+		// same slots, same links: the pool is copied byte for byte
+		reserve(source._used);
+		if (source._used > 0) {
+			std::memcpy(static_cast<void*>(_pool), source._pool, source._used * sizeof(_Node));
+		}
+		_used = source._used;
+		_free = source._free;
+		_head = source._head;
+		_tail = source._tail;
+		_size = source._size;
+	}
+	else {
+		extend(source);
+	}
+}
+
+template <typename ItemType, typename Allocator>
+uint32_t PooledDList<ItemType, Allocator>::_find(long position) const {
+	if (position >= _size || position < -_size) {
+		return _npos;
+	}
+	if (position >= 0) {
+		auto current = _head;
+		for (long i = 0; i < position; i++) {
+			current = _pool[current]._next;
+		}
+		return current;
+	}
+	else {
+		auto current = _tail;
+		for (long i = -1; i > position; i--) {
+			current = _pool[current]._prev;
+		}
+		return current;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+uint32_t PooledDList<ItemType, Allocator>::_new_node(const ItemType& x) {
+	uint32_t i;
+	if (_free != _npos) {
+		i = _free;
+		_free = _pool[i]._next;
+		::new (static_cast<void*>(_pool[i]._storage)) ItemType(x);
+		return i;
+	}
+	if (_used == _capacity) {
+		if (_capacity == _npos) {
+			// slot _npos itself is never used, so there is no index left to hand out
+			throw std::length_error("PooledDList: too many nodes for 32-bit links");
+		}
+		ItemType value(x); // x may refer into the pool that is about to move
+		_relocate(_capacity ? 2 * _capacity : 8);
+		i = static_cast<uint32_t>(_used++);
+		::new (static_cast<void*>(_pool[i]._storage)) ItemType(std::move(value));
+		return i;
+	}
+	i = static_cast<uint32_t>(_used++);
+	::new (static_cast<void*>(_pool[i]._storage)) ItemType(x);
+	return i;
+}
+
+template <typename ItemType, typename Allocator>
+void PooledDList<ItemType, Allocator>::_relocate(size_t newCapacity) {
+	if (newCapacity > _npos) {
+		newCapacity = _npos; // slot _npos itself is never used; _new_node stops there
+	}
+	_Node* pool = _NodeTraits::allocate(_alloc, newCapacity);
+	if (_used > 0) {
+		// links and free-slot chains carry over unchanged
+		std::memcpy(static_cast<void*>(pool), _pool, _used * sizeof(_Node));
+		if (!_relocatable) {
+			for (auto i = _head; i != _npos; i = _pool[i]._next) {
+				::new (static_cast<void*>(pool[i]._storage)) ItemType(std::move(_item(i)));
+				std::destroy_at(&_item(i));
+			}
+		}
+	}
+	if (_pool) {
+		_NodeTraits::deallocate(_alloc, _pool, _capacity);
+	}
+	_pool = pool;
+	_capacity = newCapacity;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType PooledDList<ItemType, Allocator>::_erase(uint32_t i) {
+	auto previous = _pool[i]._prev;
+	auto next = _pool[i]._next;
+	if (previous != _npos) {
+		_pool[previous]._next = next;
+	}
+	else {
+		_head = next;
+	}
+	if (next != _npos) {
+		_pool[next]._prev = previous;
+	}
+	else {
+		_tail = previous;
+	}
+	--_size;
+
+	ItemType item = std::move(_item(i));
+	std::destroy_at(&_item(i));
+	_pool[i]._next = _free;
+	_free = i;
+	return item;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType PooledDList<ItemType, Allocator>::_delete(long position) {
+	// normalize negative indices
+	if (position < 0) position += _size;
+
+	// invalid index -> no exceptions allowed, so return default value
+	if (position < 0 || position >= _size) {
+		return ItemType{};
+	}
+
+	return _erase(_find(position));
+}
+
+#endif /* PooledDList_hpp */
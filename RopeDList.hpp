@@ -0,0 +1,609 @@
+// RopeDList.hpp
+#ifndef RopeDList_hpp
+#define RopeDList_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/// list with the same interface as DList stored as a balanced order-statistic tree
+/// (an implicit treap: in-order position is the index, each node knows its subtree
+/// size); operator[], insert and pop take expected O(log n) time, and a list can be
+/// cut in two with split() or joined with a consumed list by extend() in O(log n)
+template <typename ItemType, typename Allocator = std::allocator<ItemType>>
+class RopeDList {
+
+public:
+    using allocator_type = Allocator;
+
+    /// constructor
+    RopeDList();
+
+    /// constructor that obtains all nodes from alloc
+    /// @param alloc allocator to use for this list's nodes
+    explicit RopeDList(const Allocator& alloc);
+
+    /// copy constructor
+    RopeDList(const RopeDList& source);
+
+    /// move constructor; takes over source's tree in O(1)
+    RopeDList(RopeDList&& source) noexcept;
+
+    /// destructor
+    ~RopeDList();
+
+    /// assignment operator
+    RopeDList& operator=(const RopeDList& source);
+
+    /// move assignment operator; takes over source's tree when the allocators allow it
+    RopeDList& operator=(RopeDList&& source);
+
+    /// returns the number of items in the list
+    size_t length() const { return _root ? _root->_count : 0; }
+
+    /// item at index specified by position
+    /// @param position index of item to return
+    /// @return item at index specified by position
+    ItemType operator[](long position) const;
+
+    /// reference to item at index specified by position
+    /// @param position index of item to return
+    /// @return reference to item at index specified by position
+    ItemType& operator[](long position);
+
+    /// removes all elements from the list
+    void clear();
+
+    /// adds the value x onto the end of the list
+    /// @param x value to add to the end of the list
+    void append(const ItemType& x);
+
+    /// inserts x at the index (negative or non-negative) at the specified position; note if
+    /// position is beyond the end, it adds to the end of the list or if position is beyond
+    /// the beginning it inserts at the beginning
+    /// @param position index to insert at
+    /// @param x value to insert at specified position
+    void insert(long position, const ItemType& x);
+
+    /// remove and return element at index specified by position
+    /// @param position index of element to remove
+    ItemType pop(long position = -1);
+
+    /// removes element from the list
+    /// @param x element to remove
+    void remove(ItemType x);
+
+    /// returns non-negative index of x starting at index start
+    /// @param x value to find the index of
+    /// @return non-negative index of x or -1 if not found
+    size_t index(ItemType x, size_t start = 0) const;
+
+    /// returns number of copies of x in the list
+    /// @param x value to count
+    /// @return number of copies of x in the list
+    int count(ItemType x) const;
+
+    /// adds each element of otherList onto this list; copying them costs O(m), joining them on O(log n)
+    /// @param otherList list to add the elements of
+    void extend(const RopeDList& otherList);
+
+    /// moves all elements of otherList onto the end of this list in O(log n), leaving
+    /// otherList empty; if the allocators differ the elements are copied instead
+    /// @param otherList list to take the elements of
+    void extend(RopeDList&& otherList);
+
+    /// cuts the list in two in O(log n): this list keeps the items before position and
+    /// the rest are returned; position is clamped the same way insert does
+    /// @param position index of the first item of the returned list
+    /// @return list of the items from position to the end
+    RopeDList split(long position);
+
+    /// returns a copy of the allocator used by this list
+    allocator_type get_allocator() const { return allocator_type(_alloc); }
+
+    /// returns the bytes of the list object plus all node storage it holds from its
+    /// allocator; heap memory owned by the items is not counted
+    size_t bytes_used() const { return sizeof(RopeDList) + length() * sizeof(_Node); }
+
+    /// returns the number of nodes on the longest path from the root down, which bounds
+    /// the work of operator[], insert and pop; expected O(log n), computed in O(n)
+    size_t height() const;
+
+private:
+    // tree node; _count is the number of nodes in the subtree rooted here, and
+    // _priority is no smaller than the priority of any node below
+    struct _Node {
+        _Node(const ItemType& item, uint32_t priority) : _item(item), _priority(priority) {}
+
+        ItemType _item;
+        _Node* _left = nullptr;
+        _Node* _right = nullptr;
+        size_t _count = 1;
+        uint32_t _priority;
+    };
+    using _NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_Node>;
+    using _NodeTraits = std::allocator_traits<_NodeAllocator>;
+
+    static size_t _count_of(const _Node* node) { return node ? node->_count : 0; }
+
+    /// recomputes node->_count from its children
+    static void _update(_Node* node) { node->_count = 1 + _count_of(node->_left) + _count_of(node->_right); }
+
+    /// splits tree into the first position nodes and the rest
+    /// @param tree root of the tree to split
+    /// @param position number of nodes that go to left
+    /// @param left set to the root of the first part
+    /// @param right set to the root of the second part
+    static void _split(_Node* tree, size_t position, _Node*& left, _Node*& right);
+
+    /// joins two trees, all of left's nodes ordered before all of right's; equal
+    /// priorities are ordered at random so repeated joins stay balanced
+    /// @return root of the joined tree
+    _Node* _merge(_Node* left, _Node* right);
+
+    /// returns a random node priority
+    uint32_t _random_priority();
+
+    /// allocates and constructs a node with a random priority
+    /// @param item value to store in the node
+    _Node* _new_node(const ItemType& item);
+
+    /// destroys and deallocates a node obtained from _new_node
+    /// @param node node to free
+    void _delete_node(_Node* node);
+
+    /// frees every node of a tree iteratively (rotating left children up as it goes)
+    /// @param tree root of the tree to free
+    void _free_tree(_Node* tree);
+
+    /// returns a copy of a tree made with this list's allocator; the copy is rebuilt
+    /// balanced with fresh priorities, so it shares none with the source
+    /// @param tree root of the tree to copy
+    _Node* _copy_tree(const _Node* tree);
+
+    /// links nodes[first, last) into a balanced tree in order and restores the heap
+    /// order of their priorities
+    /// @param nodes unlinked nodes in list order
+    /// @param first index of the first node of the subtree
+    /// @param last index one past the last node of the subtree
+    /// @return root of the subtree
+    static _Node* _build_tree(_Node* const* nodes, size_t first, size_t last);
+
+    /// returns node at specified index
+    /// @param position index from -length() to length()
+    /// @return node at specified position or nullptr if position is out of range
+    _Node* _find(long position) const;
+
+    /// calls visit(item) for the items from index start onward in order until it returns true
+    /// @param start index of the first item to visit
+    /// @param visit callable taking const ItemType& and returning bool
+    /// @return index of the item visit returned true for, or -1
+    template <typename Visit>
+    long _scan(size_t start, Visit visit) const;
+
+    /// remove and return the element at the specified index
+    /// if index is invalid, it does nothing
+    /// @param position index of element to remove
+    ItemType _delete(long position);
+
+    // allocator the nodes are obtained from
+    _NodeAllocator _alloc;
+
+    // root of the tree
+    _Node* _root;
+
+    // state of the xorshift generator that picks node priorities
+    uint64_t _random;
+};
+
+
+template <typename ItemType, typename Allocator>
+RopeDList<ItemType, Allocator>::RopeDList() : RopeDList(Allocator()) {
+}
+
+template <typename ItemType, typename Allocator>
+RopeDList<ItemType, Allocator>::RopeDList(const Allocator& alloc) : _alloc(alloc) {
+	_root = nullptr;
+	_random = 0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(this);
+}
+
+template <typename ItemType, typename Allocator>
+RopeDList<ItemType, Allocator>::RopeDList(const RopeDList& source)
+	: RopeDList(Allocator(_NodeTraits::select_on_container_copy_construction(source._alloc))) {
+	_root = _copy_tree(source._root);
+}
+
+template <typename ItemType, typename Allocator>
+RopeDList<ItemType, Allocator>::RopeDList(RopeDList&& source) noexcept : _alloc(std::move(source._alloc)) {
+	_root = source._root;
+	_random = source._random;
+	source._root = nullptr;
+}
+
+template <typename ItemType, typename Allocator>
+RopeDList<ItemType, Allocator>::~RopeDList() {
+	_free_tree(_root);
+}
+
+template <typename ItemType, typename Allocator>
+RopeDList<ItemType, Allocator>& RopeDList<ItemType, Allocator>::operator=(const RopeDList& source) {
+	if (this != &source) {
+		clear();
+		if constexpr (_NodeTraits::propagate_on_container_copy_assignment::value) {
+			_alloc = source._alloc;
+		}
+		_root = _copy_tree(source._root);
+	}
+	return *this;
+}
+
+template <typename ItemType, typename Allocator>
+RopeDList<ItemType, Allocator>& RopeDList<ItemType, Allocator>::operator=(RopeDList&& source) {
+	if (this != &source) {
+		clear();
+		if constexpr (_NodeTraits::propagate_on_container_move_assignment::value) {
+			_alloc = std::move(source._alloc);
+		}
+		extend(std::move(source));
+	}
+	return *this;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType RopeDList<ItemType, Allocator>::operator[](long position) const {
+	return _find(position)->_item;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType& RopeDList<ItemType, Allocator>::operator[](long position) {
+	return _find(position)->_item;
+}
+
+template <typename ItemType, typename Allocator>
+void RopeDList<ItemType, Allocator>::clear() {
+	auto tree = _root;
+	_root = nullptr;
+	_free_tree(tree);
+}
+
+template <typename ItemType, typename Allocator>
+void RopeDList<ItemType, Allocator>::append(const ItemType& x) {
+	_root = _merge(_root, _new_node(x));
+}
+
+template <typename ItemType, typename Allocator>
+void RopeDList<ItemType, Allocator>::insert(long position, const ItemType& x) {
+	long size = static_cast<long>(length());
+	if (position < 0) { // convert negative position to positive to insert at index
+		position += size;
+	}
+	if (position < 0) { // if still negative, set to 0 so we can insert at front
+		position = 0;
+	}
+	if (position > size) { // if beyond end, set to end so we can append
+		position = size;
+	}
+
+	auto node = _new_node(x);
+	_Node* left;
+	_Node* right;
+	_split(_root, static_cast<size_t>(position), left, right);
+	_root = _merge(_merge(left, node), right);
+}
+
+template <typename ItemType, typename Allocator>
+ItemType RopeDList<ItemType, Allocator>::pop(long position) {
+	return _delete(position);
+}
+
+template <typename ItemType, typename Allocator>
+void RopeDList<ItemType, Allocator>::remove(ItemType x) {
+	long index = _scan(0, [&](const ItemType& item) { return item == x; });
+	if (index >= 0) {
+		_delete(index);
+	}
+}
+
+template <typename ItemType, typename Allocator>
+size_t RopeDList<ItemType, Allocator>::index(ItemType x, size_t start) const {
+	return _scan(start, [&](const ItemType& item) { return item == x; });
+}
+
+template <typename ItemType, typename Allocator>
+int RopeDList<ItemType, Allocator>::count(ItemType x) const {
+	int count = 0;
+	_scan(0, [&](const ItemType& item) { count += (item == x); return false; });
+	return count;
+}
+
+template <typename ItemType, typename Allocator>
+size_t RopeDList<ItemType, Allocator>::height() const {
+	// explicit stack, so an unbalanced tree cannot overflow the call stack
+	size_t height = 0;
+	std::vector<std::pair<const _Node*, size_t>> pending;
+	if (_root != nullptr) {
+		pending.emplace_back(_root, 1);
+	}
+	while (!pending.empty()) {
+		auto [node, depth] = pending.back();
+		pending.pop_back();
+		height = depth > height ? depth : height;
+		if (node->_left != nullptr) {
+			pending.emplace_back(node->_left, depth + 1);
+		}
+		if (node->_right != nullptr) {
+			pending.emplace_back(node->_right, depth + 1);
+		}
+	}
+	return height;
+}
+
+template <typename ItemType, typename Allocator>
+void RopeDList<ItemType, Allocator>::extend(const RopeDList& otherList) {
+	_root = _merge(_root, _copy_tree(otherList._root));
+}
+
+template <typename ItemType, typename Allocator>
+void RopeDList<ItemType, Allocator>::extend(RopeDList&& otherList) {
+	if (&otherList == this) {
+		extend(static_cast<const RopeDList&>(otherList));
+		return;
+	}
+	if (_alloc == otherList._alloc) {
+		_root = _merge(_root, otherList._root);
+		otherList._root = nullptr;
+	}
+	else {
+		extend(static_cast<const RopeDList&>(otherList));
+		otherList.clear();
+	}
+}
+
+template <typename ItemType, typename Allocator>
+RopeDList<ItemType, Allocator> RopeDList<ItemType, Allocator>::split(long position) {
+	long size = static_cast<long>(length());
+	if (position < 0) {
+		position += size;
+	}
+	if (position < 0) {
+		position = 0;
+	}
+	if (position > size) {
+		position = size;
+	}
+
+	RopeDList rest{Allocator(_alloc)};
+	_split(_root, static_cast<size_t>(position), _root, rest._root);
+	return rest;
+}
+
+template <typename ItemType, typename Allocator>
+void RopeDList<ItemType, Allocator>::_split(_Node* tree, size_t position, _Node*& left, _Node*& right) {
+	if (tree == nullptr) {
+		left = nullptr;
+		right = nullptr;
+		return;
+	}
+	if (_count_of(tree->_left) < position) {
+		_split(tree->_right, position - _count_of(tree->_left) - 1, tree->_right, right);
+		left = tree;
+	}
+	else {
+		_split(tree->_left, position, left, tree->_left);
+		right = tree;
+	}
+	_update(tree);
+}
+
+template <typename ItemType, typename Allocator>
+typename RopeDList<ItemType, Allocator>::_Node* RopeDList<ItemType, Allocator>::_merge(_Node* left, _Node* right) {
+	if (left == nullptr) {
+		return right;
+	}
+	if (right == nullptr) {
+		return left;
+	}
+	if (left->_priority > right->_priority
+		|| (left->_priority == right->_priority && (_random_priority() & 1))) {
+		left->_right = _merge(left->_right, right);
+		_update(left);
+		return left;
+	}
+	right->_left = _merge(left, right->_left);
+	_update(right);
+	return right;
+}
+
+template <typename ItemType, typename Allocator>
+uint32_t RopeDList<ItemType, Allocator>::_random_priority() {
+	_random ^= _random << 13;
+	_random ^= _random >> 7;
+	_random ^= _random << 17;
+	return static_cast<uint32_t>(_random >> 32);
+}
+
+template <typename ItemType, typename Allocator>
+typename RopeDList<ItemType, Allocator>::_Node* RopeDList<ItemType, Allocator>::_new_node(const ItemType& item) {
+	_Node* node = _NodeTraits::allocate(_alloc, 1);
+	try {
+		_NodeTraits::construct(_alloc, node, item, _random_priority());
+	}
+	catch (...) {
+		_NodeTraits::deallocate(_alloc, node, 1);
+		throw;
+	}
+	return node;
+}
+
+template <typename ItemType, typename Allocator>
+void RopeDList<ItemType, Allocator>::_delete_node(_Node* node) {
+	_NodeTraits::destroy(_alloc, node);
+	_NodeTraits::deallocate(_alloc, node, 1);
+}
+
+template <typename ItemType, typename Allocator>
+void RopeDList<ItemType, Allocator>::_free_tree(_Node* tree) {
+	while (tree != nullptr) {
+		if (tree->_left != nullptr) {
+			// rotate the left child up so the tree degenerates into a right spine
+			auto left = tree->_left;
+			tree->_left = left->_right;
+			left->_right = tree;
+			tree = left;
+		}
+		else {
+			auto right = tree->_right;
+			_delete_node(tree);
+			tree = right;
+		}
+	}
+}
+
+template <typename ItemType, typename Allocator>
+typename RopeDList<ItemType, Allocator>::_Node* RopeDList<ItemType, Allocator>::_copy_tree(const _Node* tree) {
+	// copy the items in order, then rebuild; copying the source's priorities would give
+	// a self-extended list two halves with identical priorities, which _merge cannot
+	// interleave, so every self-extend would add a level to the tree
+	std::vector<_Node*> nodes;
+	nodes.reserve(_count_of(tree));
+	std::vector<const _Node*> pending;
+	try {
+		while (tree != nullptr || !pending.empty()) {
+			for (; tree != nullptr; tree = tree->_left) {
+				pending.push_back(tree);
+			}
+			tree = pending.back();
+			pending.pop_back();
+			nodes.push_back(_new_node(tree->_item));
+			tree = tree->_right;
+		}
+	}
+	catch (...) {
+		for (auto node : nodes) {
+			_delete_node(node);
+		}
+		throw;
+	}
+	return _build_tree(nodes.data(), 0, nodes.size());
+}
+
+template <typename ItemType, typename Allocator>
+typename RopeDList<ItemType, Allocator>::_Node* RopeDList<ItemType, Allocator>::_build_tree(_Node* const* nodes, size_t first, size_t last) {
+	if (first == last) {
+		return nullptr;
+	}
+	size_t middle = first + (last - first) / 2;
+	auto root = nodes[middle];
+	root->_left = _build_tree(nodes, first, middle);
+	root->_right = _build_tree(nodes, middle + 1, last);
+	_update(root);
+
+	// sift the root's priority down; both subtrees are already heap ordered
+	for (auto node = root; ; ) {
+		auto larger = node->_left;
+		if (node->_right != nullptr && (larger == nullptr || node->_right->_priority > larger->_priority)) {
+			larger = node->_right;
+		}
+		if (larger == nullptr || larger->_priority <= node->_priority) {
+			break;
+		}
+		std::swap(node->_priority, larger->_priority);
+		node = larger;
+	}
+	return root;
+}
+
+template <typename ItemType, typename Allocator>
+typename RopeDList<ItemType, Allocator>::_Node* RopeDList<ItemType, Allocator>::_find(long position) const {
+	long size = static_cast<long>(length());
+	if (position >= size || position < -size) {
+		return nullptr;
+	}
+	if (position < 0) {
+		position += size;
+	}
+	auto node = _root;
+	auto index = static_cast<size_t>(position);
+	while (true) {
+		size_t leftCount = _count_of(node->_left);
+		if (index < leftCount) {
+			node = node->_left;
+		}
+		else if (index == leftCount) {
+			return node;
+		}
+		else {
+			index -= leftCount + 1;
+			node = node->_right;
+		}
+	}
+}
+
+template <typename ItemType, typename Allocator>
+template <typename Visit>
+long RopeDList<ItemType, Allocator>::_scan(size_t start, Visit visit) const {
+	if (start >= length()) {
+		return -1;
+	}
+
+	// descend to the start node, remembering the ancestors still to be visited
+	std::vector<const _Node*> pending;
+	const _Node* node = _root;
+	size_t offset = start;
+	while (node != nullptr) {
+		size_t leftCount = _count_of(node->_left);
+		if (offset <= leftCount) {
+			pending.push_back(node);
+			if (offset == leftCount) {
+				break;
+			}
+			node = node->_left;
+		}
+		else {
+			offset -= leftCount + 1;
+			node = node->_right;
+		}
+	}
+
+	// in-order walk from there
+	long index = static_cast<long>(start);
+	while (!pending.empty()) {
+		node = pending.back();
+		pending.pop_back();
+		if (visit(node->_item)) {
+			return index;
+		}
+		++index;
+		for (node = node->_right; node != nullptr; node = node->_left) {
+			pending.push_back(node);
+		}
+	}
+	return -1;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType RopeDList<ItemType, Allocator>::_delete(long position) {
+	long size = static_cast<long>(length());
+
+	// normalize negative indices
+	if (position < 0) position += size;
+
+	// invalid index -> no exceptions allowed, so return default value
+	if (position < 0 || position >= size) {
+		return ItemType{};
+	}
+
+	_Node* left;
+	_Node* middle;
+	_Node* right;
+	_split(_root, static_cast<size_t>(position), left, middle);
+	_split(middle, 1, middle, right);
+	_root = _merge(left, right);
+	ItemType item = std::move(middle->_item);
+	_delete_node(middle);
+	return item;
+}
+
+#endif /* RopeDList_hpp */
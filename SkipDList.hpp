@@ -0,0 +1,443 @@
+// SkipDList.hpp
+#ifndef SkipDList_hpp
+#define SkipDList_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+/// indexable skip list with the same interface as DList; every forward link records
+/// how many positions it spans, so operator[], insert and pop at any position take
+/// expected O(log n) time instead of a walk from one end
+template <typename ItemType, typename Allocator = std::allocator<ItemType>>
+class SkipDList {
+
+public:
+    using allocator_type = Allocator;
+
+    /// constructor
+    SkipDList();
+
+    /// constructor that obtains all nodes from alloc
+    /// @param alloc allocator to use for this list's nodes
+    explicit SkipDList(const Allocator& alloc);
+
+    /// copy constructor
+    SkipDList(const SkipDList& source);
+
+    /// destructor
+    ~SkipDList();
+
+    /// assignment operator
+    SkipDList& operator=(const SkipDList& source);
+
+    /// returns the number of items in the list
+    size_t length() const { return _size; }
+
+    /// item at index specified by position
+    /// @param position index of item to return
+    /// @return item at index specified by position
+    ItemType operator[](long position) const;
+
+    /// reference to item at index specified by position
+    /// @param position index of item to return
+    /// @return reference to item at index specified by position
+    ItemType& operator[](long position);
+
+    /// removes all elements from the list
+    void clear();
+
+    /// adds the value x onto the end of the list
+    /// @param x value to add to the end of the list
+    void append(const ItemType& x);
+
+    /// inserts x at the index (negative or non-negative) at the specified position; note if
+    /// position is beyond the end, it adds to the end of the list or if position is beyond
+    /// the beginning it inserts at the beginning
+    /// @param position index to insert at
+    /// @param x value to insert at specified position
+    void insert(long position, const ItemType& x);
+
+    /// remove and return element at index specified by position
+    /// @param position index of element to remove
+    ItemType pop(long position = -1);
+
+    /// removes element from the list
+    /// @param x element to remove
+    void remove(ItemType x);
+
+    /// returns non-negative index of x starting at index start
+    /// @param x value to find the index of
+    /// @return non-negative index of x or -1 if not found
+    size_t index(ItemType x, size_t start = 0) const;
+
+    /// returns number of copies of x in the list
+    /// @param x value to count
+    /// @return number of copies of x in the list
+    int count(ItemType x) const;
+
+    /// adds each element of otherList onto this list
+    /// @param otherList list to add the elements of
+    void extend(const SkipDList& otherList);
+
+    /// returns a copy of the allocator used by this list
+    allocator_type get_allocator() const { return allocator_type(_alloc); }
+
+    /// returns the bytes of the list object plus all node storage it holds from its
+    /// allocator; heap memory owned by the items is not counted
+    size_t bytes_used() const { return sizeof(SkipDList) + _nodeBytes; }
+
+private:
+    // number of levels; with a promotion probability of 1/4 this covers 4^16 items
+    static constexpr unsigned _maxLevel = 16;
+
+    struct _Node;
+
+    // forward link at one level; _width is the number of positions it advances, where
+    // the position past the last item is length() (so links to nullptr have widths too)
+    struct _Link {
+        _Node* _next;
+        long _width;
+    };
+
+    // node of the list, followed in the same allocation by _height links
+    struct _Node {
+        _Node(const ItemType& item, unsigned height) : _item(item), _height(height) {}
+
+        _Link* _links() { return reinterpret_cast<_Link*>(reinterpret_cast<char*>(this) + _linksOffset); }
+
+        ItemType _item;
+        unsigned _height;
+    };
+
+    // offset of the links behind a node and the unit node storage is allocated in
+    static constexpr size_t _linksOffset = (sizeof(_Node) + alignof(_Link) - 1) / alignof(_Link) * alignof(_Link);
+    struct alignas(alignof(_Node) > alignof(_Link) ? alignof(_Node) : alignof(_Link)) _Block {
+        unsigned char _bytes[alignof(_Node) > alignof(_Link) ? alignof(_Node) : alignof(_Link)];
+    };
+    using _BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_Block>;
+    using _BlockTraits = std::allocator_traits<_BlockAllocator>;
+
+    /// returns the number of blocks a node of the given height occupies
+    static size_t _blocks(unsigned height) {
+        return (_linksOffset + height * sizeof(_Link) + sizeof(_Block) - 1) / sizeof(_Block);
+    }
+
+    /// returns a random node height, each further level with probability 1/4
+    unsigned _random_height();
+
+    /// allocates and constructs a node with a random height
+    /// @param item value to store in the node
+    _Node* _new_node(const ItemType& item);
+
+    /// destroys and deallocates a node obtained from _new_node
+    /// @param node node to free
+    void _delete_node(_Node* node);
+
+    /// returns node at specified index
+    /// @param position index from -length() to length()
+    /// @return node at specified position or nullptr if position is out of range
+    _Node* _find(long position) const;
+
+    /// links node in so that it ends up at index position
+    /// @param position index from 0 to length()
+    /// @param node unlinked node
+    void _link(long position, _Node* node);
+
+    /// unlinks and returns the node at index position
+    /// @param position index from 0 to length() - 1
+    _Node* _unlink(long position);
+
+    /// remove and return the element at the specified index
+    /// if index is invalid, it does nothing
+    /// @param position index of element to remove
+    ItemType _delete(long position);
+
+    /// sets every head link to nullptr with the width of an empty list
+    void _reset_head();
+
+    // allocator the nodes are obtained from
+    _BlockAllocator _alloc;
+
+    // links of the head sentinel, which sits at position -1
+    _Link _head[_maxLevel];
+
+    // number of items in the list
+    long _size;
+
+    // bytes of node storage currently allocated
+    size_t _nodeBytes;
+
+    // state of the xorshift generator that picks node heights
+    uint64_t _random;
+};
+
+
+template <typename ItemType, typename Allocator>
+SkipDList<ItemType, Allocator>::SkipDList() : SkipDList(Allocator()) {
+}
+
+template <typename ItemType, typename Allocator>
+SkipDList<ItemType, Allocator>::SkipDList(const Allocator& alloc) : _alloc(alloc) {
+	_size = 0;
+	_nodeBytes = 0;
+	_random = 0x9E3779B97F4A7C15ull ^ reinterpret_cast<uintptr_t>(this);
+	_reset_head();
+}
+
+template <typename ItemType, typename Allocator>
+SkipDList<ItemType, Allocator>::SkipDList(const SkipDList& source)
+	: SkipDList(Allocator(_BlockTraits::select_on_container_copy_construction(source._alloc))) {
+	extend(source);
+}
+
+template <typename ItemType, typename Allocator>
+SkipDList<ItemType, Allocator>::~SkipDList() {
+	clear();
+}
+
+template <typename ItemType, typename Allocator>
+SkipDList<ItemType, Allocator>& SkipDList<ItemType, Allocator>::operator=(const SkipDList& source) {
+	if (this != &source) {
+		clear();
+		if constexpr (_BlockTraits::propagate_on_container_copy_assignment::value) {
+			_alloc = source._alloc;
+		}
+		extend(source);
+	}
+	return *this;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType SkipDList<ItemType, Allocator>::operator[](long position) const {
+	return _find(position)->_item;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType& SkipDList<ItemType, Allocator>::operator[](long position) {
+	return _find(position)->_item;
+}
+
+template <typename ItemType, typename Allocator>
+void SkipDList<ItemType, Allocator>::clear() {
+	auto node = _head[0]._next;
+	while (node != nullptr) {
+		auto next = node->_links()[0]._next;
+		_delete_node(node);
+		node = next;
+	}
+	_size = 0;
+	_reset_head();
+}
+
+template <typename ItemType, typename Allocator>
+void SkipDList<ItemType, Allocator>::append(const ItemType& x) {
+	_link(_size, _new_node(x));
+}
+
+template <typename ItemType, typename Allocator>
+void SkipDList<ItemType, Allocator>::insert(long position, const ItemType& x) {
+
+	if (position < 0) { // convert negative position to positive to insert at index
+		position += _size;
+	}
+	if (position < 0) { // if still negative, set to 0 so we can insert at front
+		position = 0;
+	}
+	if (position > _size) { // if beyond end, set to end so we can append
+		position = _size;
+	}
+
+	_link(position, _new_node(x));
+}
+
+template <typename ItemType, typename Allocator>
+ItemType SkipDList<ItemType, Allocator>::pop(long position) {
+	return _delete(position);
+}
+
+template <typename ItemType, typename Allocator>
+void SkipDList<ItemType, Allocator>::remove(ItemType x) {
+	long index = 0;
+	for (auto node = _head[0]._next; node != nullptr; node = node->_links()[0]._next, ++index) {
+		if (node->_item == x) {
+			_delete_node(_unlink(index));
+			return;
+		}
+	}
+}
+
+template <typename ItemType, typename Allocator>
+size_t SkipDList<ItemType, Allocator>::index(ItemType x, size_t start) const {
+	auto node = _find(static_cast<long>(start));
+	auto index = start;
+	while (node != nullptr) {
+		if (node->_item == x) {
+			return index;
+		}
+		node = node->_links()[0]._next;
+		++index;
+	}
+	return -1;
+}
+
+template <typename ItemType, typename Allocator>
+int SkipDList<ItemType, Allocator>::count(ItemType x) const {
+	int count = 0;
+	for (auto node = _head[0]._next; node != nullptr; node = node->_links()[0]._next) {
+		if (node->_item == x) {
+			++count;
+		}
+	}
+	return count;
+}
+
+template <typename ItemType, typename Allocator>
+void SkipDList<ItemType, Allocator>::extend(const SkipDList& otherList) {
+	// for self-extension only the items present at the start are appended
+	long n = otherList._size;
+	auto node = otherList._head[0]._next;
+	for (long i = 0; i < n; ++i) {
+		append(node->_item);
+		node = node->_links()[0]._next;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+unsigned SkipDList<ItemType, Allocator>::_random_height() {
+	_random ^= _random << 13;
+	_random ^= _random >> 7;
+	_random ^= _random << 17;
+	unsigned height = 1;
+	for (auto bits = _random; height < _maxLevel && (bits & 3) == 0; bits >>= 2) {
+		++height;
+	}
+	return height;
+}
+
+template <typename ItemType, typename Allocator>
+typename SkipDList<ItemType, Allocator>::_Node* SkipDList<ItemType, Allocator>::_new_node(const ItemType& item) {
+	unsigned height = _random_height();
+	size_t blocks = _blocks(height);
+	_Block* storage = _BlockTraits::allocate(_alloc, blocks);
+	_Node* node;
+	try {
+		node = ::new (static_cast<void*>(storage)) _Node(item, height);
+	}
+	catch (...) {
+		_BlockTraits::deallocate(_alloc, storage, blocks);
+		throw;
+	}
+	for (unsigned level = 0; level < height; ++level) {
+		::new (static_cast<void*>(node->_links() + level)) _Link{nullptr, 0};
+	}
+	_nodeBytes += blocks * sizeof(_Block);
+	return node;
+}
+
+template <typename ItemType, typename Allocator>
+void SkipDList<ItemType, Allocator>::_delete_node(_Node* node) {
+	size_t blocks = _blocks(node->_height);
+	node->~_Node();
+	_BlockTraits::deallocate(_alloc, reinterpret_cast<_Block*>(node), blocks);
+	_nodeBytes -= blocks * sizeof(_Block);
+}
+
+template <typename ItemType, typename Allocator>
+typename SkipDList<ItemType, Allocator>::_Node* SkipDList<ItemType, Allocator>::_find(long position) const {
+	if (position >= _size || position < -_size) {
+		return nullptr;
+	}
+	if (position < 0) {
+		position += _size;
+	}
+
+	// a link is followed while it does not overshoot; links past the end never qualify
+	const _Link* links = _head;
+	_Node* node = nullptr;
+	long pos = -1;
+	for (unsigned level = _maxLevel; level-- > 0;) {
+		while (pos + links[level]._width <= position) {
+			pos += links[level]._width;
+			node = links[level]._next;
+			links = node->_links();
+		}
+	}
+	return node;
+}
+
+template <typename ItemType, typename Allocator>
+void SkipDList<ItemType, Allocator>::_link(long position, _Node* node) {
+	_Link* links = _head;
+	long pos = -1;
+	for (unsigned level = _maxLevel; level-- > 0;) {
+		// stop at the last node before position on this level
+		while (pos + links[level]._width < position) {
+			pos += links[level]._width;
+			links = links[level]._next->_links();
+		}
+		if (level < node->_height) {
+			auto& link = node->_links()[level];
+			link._next = links[level]._next;
+			link._width = pos + links[level]._width + 1 - position;
+			links[level]._next = node;
+			links[level]._width = position - pos;
+		}
+		else {
+			++links[level]._width;
+		}
+	}
+	++_size;
+}
+
+template <typename ItemType, typename Allocator>
+typename SkipDList<ItemType, Allocator>::_Node* SkipDList<ItemType, Allocator>::_unlink(long position) {
+	_Link* links = _head;
+	long pos = -1;
+	_Node* node = nullptr;
+	for (unsigned level = _maxLevel; level-- > 0;) {
+		while (pos + links[level]._width < position) {
+			pos += links[level]._width;
+			links = links[level]._next->_links();
+		}
+		auto next = links[level]._next;
+		if (next != nullptr && pos + links[level]._width == position) {
+			node = next;
+			links[level]._width += next->_links()[level]._width - 1;
+			links[level]._next = next->_links()[level]._next;
+		}
+		else {
+			--links[level]._width;
+		}
+	}
+	--_size;
+	return node;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType SkipDList<ItemType, Allocator>::_delete(long position) {
+	// normalize negative indices
+	if (position < 0) position += _size;
+
+	// invalid index -> no exceptions allowed, so return default value
+	if (position < 0 || position >= _size) {
+		return ItemType{};
+	}
+
+	auto node = _unlink(position);
+	ItemType item = std::move(node->_item);
+	_delete_node(node);
+	return item;
+}
+
+template <typename ItemType, typename Allocator>
+void SkipDList<ItemType, Allocator>::_reset_head() {
+	for (auto& link : _head) {
+		link._next = nullptr;
+		link._width = 1; // from position -1 to the end of an empty list
+	}
+}
+
+#endif /* SkipDList_hpp */
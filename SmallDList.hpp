@@ -0,0 +1,400 @@
+// SmallDList.hpp
+#ifndef SmallDList_hpp
+#define SmallDList_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include "DList.hpp"
+
+/// list with the same interface as DList that keeps up to InlineCapacity items inside
+/// the object itself; once it overflows, all items move into a linked DList allocated
+/// on the side that is used until the list is cleared or popped empty, so short lists
+/// never allocate and the object holds only the inline items and a pointer
+template <typename ItemType, size_t InlineCapacity = 8, typename Allocator = std::allocator<ItemType>>
+class SmallDList {
+    static_assert(InlineCapacity >= 1, "SmallDList must hold at least one item inline");
+
+public:
+    using allocator_type = Allocator;
+
+    /// constructor
+    SmallDList();
+
+    /// constructor that obtains spilled nodes from alloc
+    /// @param alloc allocator to use once the list outgrows its inline storage
+    explicit SmallDList(const Allocator& alloc);
+
+    /// copy constructor; a list that fits inline is copied item by item
+    SmallDList(const SmallDList& source);
+
+    /// destructor
+    ~SmallDList();
+
+    /// assignment operator
+    SmallDList& operator=(const SmallDList& source);
+
+    /// returns the number of items in the list
+    size_t length() const { return _spill ? _spill->length() : _inlineSize; }
+
+    /// returns true if the items are currently stored in linked nodes
+    bool spilled() const { return _spill != nullptr; }
+
+    /// item at index specified by position
+    /// @param position index of item to return
+    /// @return item at index specified by position
+    ItemType operator[](long position) const;
+
+    /// reference to item at index specified by position
+    /// @param position index of item to return
+    /// @return reference to item at index specified by position
+    ItemType& operator[](long position);
+
+    /// removes all elements from the list and returns it to inline storage
+    void clear();
+
+    /// adds the value x onto the end of the list
+    /// @param x value to add to the end of the list
+    void append(const ItemType& x);
+
+    /// inserts x at the index (negative or non-negative) at the specified position; note if
+    /// position is beyond the end, it adds to the end of the list or if position is beyond
+    /// the beginning it inserts at the beginning
+    /// @param position index to insert at
+    /// @param x value to insert at specified position
+    void insert(long position, const ItemType& x);
+
+    /// remove and return element at index specified by position
+    /// @param position index of element to remove
+    ItemType pop(long position = -1);
+
+    /// removes element from the list
+    /// @param x element to remove
+    void remove(ItemType x);
+
+    /// returns non-negative index of x starting at index start
+    /// @param x value to find the index of
+    /// @return non-negative index of x or -1 if not found
+    size_t index(ItemType x, size_t start = 0) const;
+
+    /// returns number of copies of x in the list
+    /// @param x value to count
+    /// @return number of copies of x in the list
+    int count(ItemType x) const;
+
+    /// adds each element of otherList onto this list
+    /// @param otherList list to add the elements of
+    void extend(const SmallDList& otherList);
+
+    /// returns a copy of the allocator used by this list
+    allocator_type get_allocator() const { return _alloc; }
+
+    /// returns the bytes of the list object plus all storage it holds from its allocator;
+    /// heap memory owned by the items is not counted
+    size_t bytes_used() const { return sizeof(SmallDList) + (_spill ? _spill->bytes_used() : 0); }
+
+private:
+    using _List = DList<ItemType, Allocator>;
+    using _ListAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_List>;
+    using _ListTraits = std::allocator_traits<_ListAllocator>;
+
+    ItemType* _items() { return reinterpret_cast<ItemType*>(_inline); }
+    const ItemType* _items() const { return reinterpret_cast<const ItemType*>(_inline); }
+
+    /// converts position to an index into the inline items
+    /// @param position index from -length() to length()
+    /// @return non-negative index or -1 if position is out of range
+    long _inline_index(long position) const;
+
+    /// destroys the inline items
+    void _clear_inline();
+
+    /// allocates an empty linked list that uses this list's allocator
+    /// @return the new list
+    _List* _new_spill();
+
+    /// destroys and deallocates a list obtained from _new_spill, if any
+    /// @param spill list to free, or nullptr
+    void _delete_spill(_List* spill);
+
+    /// moves the inline items into a new linked list and switches to linked storage
+    void _spill_items();
+
+    /// returns to inline storage once the linked list has been emptied
+    void _unspill_if_empty();
+
+    // storage for the first InlineCapacity items; _items()[0, _inlineSize) are constructed
+    // while the list is not spilled
+    alignas(ItemType) unsigned char _inline[InlineCapacity * sizeof(ItemType)];
+    size_t _inlineSize;
+
+    // linked storage used after the inline storage overflowed; nullptr while the items
+    // live in _inline
+    _List* _spill;
+
+    // allocator the linked list and its nodes are obtained from
+    Allocator _alloc;
+};
+
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+SmallDList<ItemType, InlineCapacity, Allocator>::SmallDList() : SmallDList(Allocator()) {
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+SmallDList<ItemType, InlineCapacity, Allocator>::SmallDList(const Allocator& alloc) : _alloc(alloc) {
+	_inlineSize = 0;
+	_spill = nullptr;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+SmallDList<ItemType, InlineCapacity, Allocator>::SmallDList(const SmallDList& source)
+	: SmallDList(std::allocator_traits<Allocator>::select_on_container_copy_construction(source._alloc)) {
+	// the delegated constructor has completed, so if a copy throws the destructor frees
+	// the inline items and the linked list copied so far
+	extend(source);
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+SmallDList<ItemType, InlineCapacity, Allocator>::~SmallDList() {
+	clear();
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+SmallDList<ItemType, InlineCapacity, Allocator>& SmallDList<ItemType, InlineCapacity, Allocator>::operator=(const SmallDList& source) {
+	if (this != &source) {
+		clear();
+		if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+			_alloc = source._alloc;
+		}
+		extend(source);
+	}
+	return *this;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+ItemType SmallDList<ItemType, InlineCapacity, Allocator>::operator[](long position) const {
+	if (_spill) {
+		return (*_spill)[position];
+	}
+	return _items()[_inline_index(position)];
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+ItemType& SmallDList<ItemType, InlineCapacity, Allocator>::operator[](long position) {
+	if (_spill) {
+		return (*_spill)[position];
+	}
+	return _items()[_inline_index(position)];
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+void SmallDList<ItemType, InlineCapacity, Allocator>::clear() {
+	_clear_inline();
+	_delete_spill(_spill);
+	_spill = nullptr;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+void SmallDList<ItemType, InlineCapacity, Allocator>::append(const ItemType& x) {
+	if (!_spill && _inlineSize < InlineCapacity) {
+		::new (static_cast<void*>(_items() + _inlineSize)) ItemType(x);
+		++_inlineSize;
+		return;
+	}
+	if (!_spill) {
+		ItemType value(x); // x may refer to an inline item
+		_spill_items();
+		_spill->append(std::move(value));
+		return;
+	}
+	_spill->append(x);
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+void SmallDList<ItemType, InlineCapacity, Allocator>::insert(long position, const ItemType& x) {
+	if (_spill) {
+		_spill->insert(position, x);
+		return;
+	}
+	if (_inlineSize == InlineCapacity) {
+		ItemType value(x); // x may refer to an inline item
+		_spill_items();
+		_spill->insert(position, std::move(value));
+		return;
+	}
+
+	long size = static_cast<long>(_inlineSize);
+	if (position < 0) { // convert negative position to positive to insert at index
+		position += size;
+	}
+	if (position < 0) { // if still negative, set to 0 so we can insert at front
+		position = 0;
+	}
+	if (position > size) { // if beyond end, set to end so we can append
+		position = size;
+	}
+
+	auto items = _items();
+	if (position == size) {
+		::new (static_cast<void*>(items + size)) ItemType(x);
+	}
+	else {
+		ItemType value(x); // x may refer to an item that is about to shift
+		::new (static_cast<void*>(items + size)) ItemType(std::move(items[size - 1]));
+		std::move_backward(items + position, items + size - 1, items + size);
+		items[position] = std::move(value);
+	}
+	++_inlineSize;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+ItemType SmallDList<ItemType, InlineCapacity, Allocator>::pop(long position) {
+	if (_spill) {
+		ItemType item = _spill->pop(position);
+		_unspill_if_empty();
+		return item;
+	}
+
+	// invalid index -> no exceptions allowed, so return default value
+	long index = _inline_index(position);
+	if (index < 0) {
+		return ItemType{};
+	}
+
+	auto items = _items();
+	ItemType item = std::move(items[index]);
+	std::move(items + index + 1, items + _inlineSize, items + index);
+	std::destroy_at(items + _inlineSize - 1);
+	--_inlineSize;
+	return item;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+void SmallDList<ItemType, InlineCapacity, Allocator>::remove(ItemType x) {
+	if (_spill) {
+		_spill->remove(x);
+		_unspill_if_empty();
+		return;
+	}
+	for (size_t i = 0; i < _inlineSize; ++i) {
+		if (_items()[i] == x) {
+			pop(static_cast<long>(i));
+			return;
+		}
+	}
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+size_t SmallDList<ItemType, InlineCapacity, Allocator>::index(ItemType x, size_t start) const {
+	if (_spill) {
+		return _spill->index(x, start);
+	}
+	for (size_t i = start; i < _inlineSize; ++i) {
+		if (_items()[i] == x) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+int SmallDList<ItemType, InlineCapacity, Allocator>::count(ItemType x) const {
+	if (_spill) {
+		return _spill->count(x);
+	}
+	int count = 0;
+	for (size_t i = 0; i < _inlineSize; ++i) {
+		if (_items()[i] == x) {
+			++count;
+		}
+	}
+	return count;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+void SmallDList<ItemType, InlineCapacity, Allocator>::extend(const SmallDList& otherList) {
+	if (otherList._spill) {
+		if (!_spill && length() + otherList.length() > InlineCapacity) {
+			_spill_items();
+		}
+		if (_spill) {
+			_spill->extend(*otherList._spill); // handles self-extension
+			return;
+		}
+	}
+
+	// for self-extension only the items present at the start are appended
+	long n = static_cast<long>(otherList.length());
+	for (long i = 0; i < n; ++i) {
+		append(otherList[i]);
+	}
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+long SmallDList<ItemType, InlineCapacity, Allocator>::_inline_index(long position) const {
+	long size = static_cast<long>(_inlineSize);
+	if (position >= size || position < -size) {
+		return -1;
+	}
+	return position < 0 ? position + size : position;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+void SmallDList<ItemType, InlineCapacity, Allocator>::_clear_inline() {
+	std::destroy_n(_items(), _inlineSize);
+	_inlineSize = 0;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+typename SmallDList<ItemType, InlineCapacity, Allocator>::_List* SmallDList<ItemType, InlineCapacity, Allocator>::_new_spill() {
+	_ListAllocator alloc(_alloc);
+	_List* spill = _ListTraits::allocate(alloc, 1);
+	try {
+		// placement new rather than construct(): a pmr allocator would try uses-allocator
+		// construction, and DList has no allocator-extended constructors
+		::new (static_cast<void*>(spill)) _List(_alloc);
+	}
+	catch (...) {
+		_ListTraits::deallocate(alloc, spill, 1);
+		throw;
+	}
+	return spill;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+void SmallDList<ItemType, InlineCapacity, Allocator>::_delete_spill(_List* spill) {
+	if (spill) {
+		_ListAllocator alloc(_alloc);
+		std::destroy_at(spill);
+		_ListTraits::deallocate(alloc, spill, 1);
+	}
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+void SmallDList<ItemType, InlineCapacity, Allocator>::_spill_items() {
+	auto spill = _new_spill();
+	try {
+		for (size_t i = 0; i < _inlineSize; ++i) {
+			spill->append(std::move(_items()[i]));
+		}
+	}
+	catch (...) {
+		_delete_spill(spill);
+		throw;
+	}
+	_clear_inline();
+	_spill = spill;
+}
+
+template <typename ItemType, size_t InlineCapacity, typename Allocator>
+void SmallDList<ItemType, InlineCapacity, Allocator>::_unspill_if_empty() {
+	if (_spill->length() == 0) {
+		_delete_spill(_spill);
+		_spill = nullptr;
+	}
+}
+
+#endif /* SmallDList_hpp */
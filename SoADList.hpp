@@ -0,0 +1,347 @@
+// SoADList.hpp
+#ifndef SoADList_hpp
+#define SoADList_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/// doubly linked list with the same interface as DList for trivially copyable ItemType,
+/// stored as a structure of arrays: the items occupy one dense array and the links live
+/// in two separate index arrays, so count streams only the payload; removal moves the
+/// last slot into the hole so every slot below length() is in use; a list holds at most
+/// 2^32 - 1 items, and adding one more throws std::length_error
+template <typename ItemType, typename Allocator = std::allocator<ItemType>>
+class SoADList {
+    static_assert(std::is_trivially_copyable<ItemType>::value, "SoADList requires a trivially copyable ItemType");
+
+public:
+    using allocator_type = Allocator;
+
+    /// constructor
+    SoADList();
+
+    /// constructor that obtains the arrays from alloc
+    /// @param alloc allocator to use for this list's arrays
+    explicit SoADList(const Allocator& alloc);
+
+    // copy construction and assignment copy the three arrays
+
+    /// returns the number of items in the list
+    size_t length() const { return _items.size(); }
+
+    /// grows the arrays so they can hold at least n items
+    /// @param n number of items to make room for
+    void reserve(size_t n);
+
+    /// item at index specified by position
+    /// @param position index of item to return
+    /// @return item at index specified by position
+    ItemType operator[](long position) const;
+
+    /// reference to item at index specified by position; it is invalidated by any insertion
+    /// or removal
+    /// @param position index of item to return
+    /// @return reference to item at index specified by position
+    ItemType& operator[](long position);
+
+    /// removes all elements from the list
+    void clear();
+
+    /// adds the value x onto the end of the list
+    /// @param x value to add to the end of the list
+    void append(const ItemType& x);
+
+    /// inserts x at the index (negative or non-negative) at the specified position; note if
+    /// position is beyond the end, it adds to the end of the list or if position is beyond
+    /// the beginning it inserts at the beginning
+    /// @param position index to insert at
+    /// @param x value to insert at specified position
+    void insert(long position, const ItemType& x);
+
+    /// remove and return element at index specified by position
+    /// @param position index of element to remove
+    ItemType pop(long position = -1);
+
+    /// removes element from the list
+    /// @param x element to remove
+    void remove(ItemType x);
+
+    /// returns non-negative index of x starting at index start
+    /// @param x value to find the index of
+    /// @return non-negative index of x or -1 if not found
+    size_t index(ItemType x, size_t start = 0) const;
+
+    /// returns number of copies of x in the list
+    /// @param x value to count
+    /// @return number of copies of x in the list
+    int count(ItemType x) const;
+
+    /// adds each element of otherList onto this list
+    /// @param otherList list to add the elements of
+    void extend(const SoADList& otherList);
+
+    /// returns a copy of the allocator used by this list
+    allocator_type get_allocator() const { return _items.get_allocator(); }
+
+    /// returns the bytes of the list object plus the capacity of its three arrays
+    size_t bytes_used() const {
+        return sizeof(SoADList) + _items.capacity() * sizeof(ItemType)
+            + (_next.capacity() + _prev.capacity()) * sizeof(uint32_t);
+    }
+
+private:
+    // link value meaning "no slot"
+    static constexpr uint32_t _npos = UINT32_MAX;
+
+    using _LinkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<uint32_t>;
+
+    /// returns slot of the item at specified index
+    /// @param position index from -length() to length()
+    /// @return slot of the item at specified position or _npos if position is out of range
+    uint32_t _find(long position) const;
+
+    /// returns the slot the next added item will occupy; throws std::length_error if every
+    /// slot index is in use
+    uint32_t _next_slot() const;
+
+    /// unlinks slot i and fills the hole with the last slot
+    /// @param i slot to remove
+    /// @return the removed item
+    ItemType _erase(uint32_t i);
+
+    // items by slot, and the slots following and preceding each slot in list order
+    std::vector<ItemType, Allocator> _items;
+    std::vector<uint32_t, _LinkAllocator> _next;
+    std::vector<uint32_t, _LinkAllocator> _prev;
+
+    // slots of the head, and tail items
+    uint32_t _head, _tail;
+};
+
+
+template <typename ItemType, typename Allocator>
+SoADList<ItemType, Allocator>::SoADList() : SoADList(Allocator()) {
+}
+
+template <typename ItemType, typename Allocator>
+SoADList<ItemType, Allocator>::SoADList(const Allocator& alloc)
+	: _items(alloc), _next(_LinkAllocator(alloc)), _prev(_LinkAllocator(alloc)) {
+	_head = _npos;
+	_tail = _npos;
+}
+
+template <typename ItemType, typename Allocator>
+void SoADList<ItemType, Allocator>::reserve(size_t n) {
+	_items.reserve(n);
+	_next.reserve(n);
+	_prev.reserve(n);
+}
+
+template <typename ItemType, typename Allocator>
+ItemType SoADList<ItemType, Allocator>::operator[](long position) const {
+	return _items[_find(position)];
+}
+
+template <typename ItemType, typename Allocator>
+ItemType& SoADList<ItemType, Allocator>::operator[](long position) {
+	return _items[_find(position)];
+}
+
+template <typename ItemType, typename Allocator>
+void SoADList<ItemType, Allocator>::clear() {
+	_items.clear();
+	_next.clear();
+	_prev.clear();
+	_head = _npos;
+	_tail = _npos;
+}
+
+template <typename ItemType, typename Allocator>
+void SoADList<ItemType, Allocator>::append(const ItemType& x) {
+	auto i = _next_slot();
+	_items.push_back(x);
+	_next.push_back(_npos);
+	_prev.push_back(_tail);
+	if (_tail == _npos) {
+		_head = i;
+	}
+	else {
+		_next[_tail] = i;
+	}
+	_tail = i;
+}
+
+template <typename ItemType, typename Allocator>
+void SoADList<ItemType, Allocator>::insert(long position, const ItemType& x) {
+	long size = static_cast<long>(_items.size());
+	if (position < 0) { // convert negative position to positive to insert at index
+		position += size;
+	}
+	if (position < 0) { // if still negative, set to 0 so we can insert at front
+		position = 0;
+	}
+	if (position > size) { // if beyond end, set to end so we can append
+		position = size;
+	}
+
+	if (size == 0 || position == size) {
+		append(x);
+		return;
+	}
+
+	auto current = _find(position);
+	auto previous = _prev[current];
+	auto i = _next_slot();
+	_items.push_back(x);
+	_next.push_back(current);
+	_prev.push_back(previous);
+	if (previous != _npos) {
+		_next[previous] = i;
+	}
+	else {
+		_head = i;
+	}
+	_prev[current] = i;
+}
+
+template <typename ItemType, typename Allocator>
+ItemType SoADList<ItemType, Allocator>::pop(long position) {
+	long size = static_cast<long>(_items.size());
+
+	// normalize negative indices
+	if (position < 0) position += size;
+
+	// invalid index -> no exceptions allowed, so return default value
+	if (position < 0 || position >= size) {
+		return ItemType{};
+	}
+	return _erase(_find(position));
+}
+
+template <typename ItemType, typename Allocator>
+void SoADList<ItemType, Allocator>::remove(ItemType x) {
+	for (auto i = _head; i != _npos; i = _next[i]) {
+		if (_items[i] == x) {
+			_erase(i);
+			return;
+		}
+	}
+}
+
+template <typename ItemType, typename Allocator>
+size_t SoADList<ItemType, Allocator>::index(ItemType x, size_t start) const {
+	auto i = _find(static_cast<long>(start));
+	auto index = start;
+	while (i != _npos) {
+		if (_items[i] == x) {
+			return index;
+		}
+		i = _next[i];
+		++index;
+	}
+	return -1;
+}
+
+template <typename ItemType, typename Allocator>
+int SoADList<ItemType, Allocator>::count(ItemType x) const {
+	// every slot is in use, so slot order does not matter
+	const ItemType* items = _items.data();
+	size_t n = _items.size();
+	int count = 0;
+	for (size_t i = 0; i < n; ++i) {
+		count += (items[i] == x);
+	}
+	return count;
+}
+
+template <typename ItemType, typename Allocator>
+void SoADList<ItemType, Allocator>::extend(const SoADList& otherList) {
+	// for self-extension only the items present at the start are appended
+	size_t n = otherList._items.size();
+	reserve(_items.size() + n);
+	auto i = otherList._head;
+	for (size_t k = 0; k < n; ++k) {
+		append(otherList._items[i]);
+		i = otherList._next[i];
+	}
+}
+
+template <typename ItemType, typename Allocator>
+uint32_t SoADList<ItemType, Allocator>::_find(long position) const {
+	long size = static_cast<long>(_items.size());
+	if (position >= size || position < -size) {
+		return _npos;
+	}
+	if (position >= 0) {
+		auto current = _head;
+		for (long i = 0; i < position; i++) {
+			current = _next[current];
+		}
+		return current;
+	}
+	else {
+		auto current = _tail;
+		for (long i = -1; i > position; i--) {
+			current = _prev[current];
+		}
+		return current;
+	}
+}
+
+template <typename ItemType, typename Allocator>
+uint32_t SoADList<ItemType, Allocator>::_next_slot() const {
+	if (_items.size() >= _npos) {
+		// slot _npos itself is never used, so there is no index left to hand out
+		throw std::length_error("SoADList: too many items for 32-bit links");
+	}
+	return static_cast<uint32_t>(_items.size());
+}
+
+template <typename ItemType, typename Allocator>
+ItemType SoADList<ItemType, Allocator>::_erase(uint32_t i) {
+	auto previous = _prev[i];
+	auto next = _next[i];
+	if (previous != _npos) {
+		_next[previous] = next;
+	}
+	else {
+		_head = next;
+	}
+	if (next != _npos) {
+		_prev[next] = previous;
+	}
+	else {
+		_tail = previous;
+	}
+
+	ItemType item = _items[i];
+	auto last = static_cast<uint32_t>(_items.size() - 1);
+	if (i != last) {
+		// move the last slot into the hole and point its neighbours at the new slot
+		_items[i] = _items[last];
+		_next[i] = _next[last];
+		_prev[i] = _prev[last];
+		if (_prev[i] != _npos) {
+			_next[_prev[i]] = i;
+		}
+		else {
+			_head = i;
+		}
+		if (_next[i] != _npos) {
+			_prev[_next[i]] = i;
+		}
+		else {
+			_tail = i;
+		}
+	}
+	_items.pop_back();
+	_next.pop_back();
+	_prev.pop_back();
+	return item;
+}
+
+#endif /* SoADList_hpp */
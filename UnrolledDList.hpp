@@ -0,0 +1,536 @@
+// UnrolledDList.hpp
+#ifndef UnrolledDList_hpp
+#define UnrolledDList_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+/// unrolled doubly linked list with the same interface as DList; each node (chunk)
+/// stores up to ChunkCapacity items contiguously, so scans touch one cache line per
+/// few items instead of one per item and the per-item link overhead is divided by
+/// the chunk fill
+template <typename ItemType, size_t ChunkCapacity = 16, typename Allocator = std::allocator<ItemType>>
+class UnrolledDList {
+    static_assert(ChunkCapacity >= 2, "UnrolledDList chunks must hold at least two items");
+
+public:
+    using allocator_type = Allocator;
+
+    /// constructor
+    UnrolledDList();
+
+    /// constructor that obtains all chunks from alloc
+    /// @param alloc allocator to use for this list's chunks
+    explicit UnrolledDList(const Allocator& alloc);
+
+    /// copy constructor
+    UnrolledDList(const UnrolledDList& source);
+
+    /// move constructor; takes over source's chunks in O(1)
+    UnrolledDList(UnrolledDList&& source) noexcept;
+
+    /// destructor
+    ~UnrolledDList();
+
+    /// assignment operator
+    UnrolledDList& operator=(const UnrolledDList& source);
+
+    /// move assignment operator; takes over source's chunks when the allocators allow it
+    /// and copies the items otherwise, leaving source empty either way
+    UnrolledDList& operator=(UnrolledDList&& source);
+
+    /// returns the number of items in the list
+    size_t length() const { return _size; }
+
+    /// item at index specified by position
+    /// @param position index of item to return
+    /// @return item at index specified by position
+    ItemType operator[](long position) const;
+
+    /// reference to item at index specified by position
+    /// @param position index of item to return
+    /// @return reference to item at index specified by position
+    ItemType& operator[](long position);
+
+    /// removes all elements from the list
+    void clear();
+
+    /// adds the value x onto the end of the list
+    /// @param x value to add to the end of the list
+    void append(const ItemType& x);
+
+    /// inserts x at the index (negative or non-negative) at the specified position; note if
+    /// position is beyond the end, it adds to the end of the list or if position is beyond
+    /// the beginning it inserts at the beginning
+    /// @param position index to insert at
+    /// @param x value to insert at specified position
+    void insert(long position, const ItemType& x);
+
+    /// remove and return element at index specified by position
+    /// @param position index of element to remove
+    ItemType pop(long position = -1);
+
+    /// removes element from the list
+    /// @param x element to remove
+    void remove(ItemType x);
+
+    /// returns non-negative index of x starting at index start
+    /// @param x value to find the index of
+    /// @return non-negative index of x or -1 if not found
+    size_t index(ItemType x, size_t start = 0) const;
+
+    /// returns number of copies of x in the list
+    /// @param x value to count
+    /// @return number of copies of x in the list
+    int count(ItemType x) const;
+
+    /// adds each element of otherList onto this list
+    /// @param otherList list to add the elements of
+    void extend(const UnrolledDList& otherList);
+
+    /// returns a copy of the allocator used by this list
+    allocator_type get_allocator() const { return allocator_type(_alloc); }
+
+    /// returns the bytes of the list object plus all storage it holds from its allocator;
+    /// heap memory owned by the items is not counted
+    size_t bytes_used() const { return sizeof(UnrolledDList) + _chunkCount * sizeof(_Chunk); }
+
+private:
+    // node of the list; _items[0, _count) are constructed, the rest is raw storage
+    struct _Chunk {
+        alignas(ItemType) unsigned char _storage[ChunkCapacity * sizeof(ItemType)];
+        size_t _count = 0;
+        _Chunk* _next = nullptr;
+        _Chunk* _prev = nullptr;
+
+        ItemType* _items() { return reinterpret_cast<ItemType*>(_storage); }
+        const ItemType* _items() const { return reinterpret_cast<const ItemType*>(_storage); }
+    };
+    using _ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<_Chunk>;
+    using _ChunkTraits = std::allocator_traits<_ChunkAllocator>;
+
+    /// helper function for copy constructor and operator=; if a copy throws, the chunks
+    /// made so far are freed and the list is left empty
+    /// @param source existing list to copy the items of into this (empty) list
+    void _copy(const UnrolledDList& source);
+
+    /// takes the chunks of source, which must use an equal allocator, and leaves it
+    /// empty; this list must hold no chunks
+    /// @param source list to take the chunks of
+    void _take(UnrolledDList& source) noexcept;
+
+    /// returns chunk holding the item at specified index
+    /// @param position index from -length() to length()
+    /// @param offset set to the index of the item within the returned chunk
+    /// @return chunk holding position or nullptr if position is out of range
+    _Chunk* _find(long position, size_t& offset) const;
+
+    /// allocates an empty chunk and links it after prev (or at the front if prev is nullptr)
+    /// @param prev chunk to link the new chunk after
+    /// @return the new chunk
+    _Chunk* _new_chunk(_Chunk* prev);
+
+    /// unlinks an empty chunk and frees it
+    /// @param chunk chunk to free
+    void _delete_chunk(_Chunk* chunk);
+
+    /// moves the upper half of a full chunk into a new chunk linked after it
+    /// @param chunk full chunk to split
+    void _split(_Chunk* chunk);
+
+    /// remove and return the item at offset within chunk; a chunk that drops below half
+    /// full is merged with a neighbour when the result leaves a quarter of a chunk free
+    /// @param chunk chunk holding the item
+    /// @param offset index of the item within chunk
+    ItemType _erase(_Chunk* chunk, size_t offset);
+
+    /// remove and return the element at the specified index
+    /// if index is invalid, it does nothing
+    /// @param position index of element to remove
+    ItemType _delete(long position);
+
+    // allocator the chunks are obtained from
+    _ChunkAllocator _alloc;
+
+    // pointers to the head, and tail chunks
+    _Chunk* _head;
+    _Chunk* _tail;
+
+    // number of items in the list
+    long _size;
+
+    // number of chunks in the list
+    size_t _chunkCount;
+};
+
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+UnrolledDList<ItemType, ChunkCapacity, Allocator>::UnrolledDList() : UnrolledDList(Allocator()) {
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+UnrolledDList<ItemType, ChunkCapacity, Allocator>::UnrolledDList(const Allocator& alloc) : _alloc(alloc) {
+	_head = nullptr;
+	_tail = nullptr;
+	_size = 0;
+	_chunkCount = 0;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+UnrolledDList<ItemType, ChunkCapacity, Allocator>::UnrolledDList(const UnrolledDList& source)
+	: UnrolledDList(Allocator(_ChunkTraits::select_on_container_copy_construction(source._alloc))) {
+	_copy(source);
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+UnrolledDList<ItemType, ChunkCapacity, Allocator>::UnrolledDList(UnrolledDList&& source) noexcept
+	: _alloc(std::move(source._alloc)) {
+	_take(source);
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+UnrolledDList<ItemType, ChunkCapacity, Allocator>::~UnrolledDList() {
+	clear();
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+UnrolledDList<ItemType, ChunkCapacity, Allocator>& UnrolledDList<ItemType, ChunkCapacity, Allocator>::operator=(const UnrolledDList& source) {
+	if (this != &source) {
+		clear();
+		if constexpr (_ChunkTraits::propagate_on_container_copy_assignment::value) {
+			_alloc = source._alloc;
+		}
+		_copy(source);
+	}
+	return *this;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+UnrolledDList<ItemType, ChunkCapacity, Allocator>& UnrolledDList<ItemType, ChunkCapacity, Allocator>::operator=(UnrolledDList&& source) {
+	if (this == &source) {
+		return *this;
+	}
+	clear();
+	if constexpr (_ChunkTraits::propagate_on_container_move_assignment::value) {
+		_alloc = std::move(source._alloc);
+	}
+	else if (!(_alloc == source._alloc)) {
+		// the chunks cannot change hands, so copy the items and empty source
+		_copy(source);
+		source.clear();
+		return *this;
+	}
+	_take(source);
+	return *this;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+ItemType UnrolledDList<ItemType, ChunkCapacity, Allocator>::operator[](long position) const {
+	size_t offset = 0;
+	return _find(position, offset)->_items()[offset];
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+ItemType& UnrolledDList<ItemType, ChunkCapacity, Allocator>::operator[](long position) {
+	size_t offset = 0;
+	return _find(position, offset)->_items()[offset];
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+void UnrolledDList<ItemType, ChunkCapacity, Allocator>::clear() {
+	auto chunk = _head;
+	_head = nullptr;
+	_tail = nullptr;
+	_size = 0;
+	_chunkCount = 0;
+	while (chunk != nullptr) {
+		auto next = chunk->_next;
+		std::destroy_n(chunk->_items(), chunk->_count);
+		_ChunkTraits::destroy(_alloc, chunk);
+		_ChunkTraits::deallocate(_alloc, chunk, 1);
+		chunk = next;
+	}
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+void UnrolledDList<ItemType, ChunkCapacity, Allocator>::append(const ItemType& x) {
+	if (_tail == nullptr || _tail->_count == ChunkCapacity) {
+		ItemType value(x); // x may refer into the tail chunk
+		_new_chunk(_tail);
+		::new (static_cast<void*>(_tail->_items())) ItemType(std::move(value));
+	}
+	else {
+		::new (static_cast<void*>(_tail->_items() + _tail->_count)) ItemType(x);
+	}
+	++_tail->_count;
+	++_size;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+void UnrolledDList<ItemType, ChunkCapacity, Allocator>::insert(long position, const ItemType& x) {
+
+	if (position < 0) { // convert negative position to positive to insert at index
+		position += _size;
+	}
+	if (position < 0) { // if still negative, set to 0 so we can insert at front
+		position = 0;
+	}
+	if (position > _size) { // if beyond end, set to end so we can append
+		position = _size;
+	}
+
+	if (_size == 0 || position == _size) {
+		append(x);
+		return;
+	}
+
+	ItemType value(x); // x may refer to an item that is about to shift
+	size_t offset = 0;
+	auto chunk = _find(position, offset);
+	if (chunk->_count == ChunkCapacity) {
+		_split(chunk);
+		if (offset > chunk->_count) {
+			offset -= chunk->_count;
+			chunk = chunk->_next;
+		}
+	}
+
+	auto items = chunk->_items();
+	if (offset == chunk->_count) {
+		::new (static_cast<void*>(items + offset)) ItemType(std::move(value));
+	}
+	else {
+		::new (static_cast<void*>(items + chunk->_count)) ItemType(std::move(items[chunk->_count - 1]));
+		std::move_backward(items + offset, items + chunk->_count - 1, items + chunk->_count);
+		items[offset] = std::move(value);
+	}
+	++chunk->_count;
+	++_size;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+ItemType UnrolledDList<ItemType, ChunkCapacity, Allocator>::pop(long position) {
+	return _delete(position);
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+void UnrolledDList<ItemType, ChunkCapacity, Allocator>::remove(ItemType x) {
+	for (auto chunk = _head; chunk != nullptr; chunk = chunk->_next) {
+		auto items = chunk->_items();
+		for (size_t i = 0; i < chunk->_count; ++i) {
+			if (items[i] == x) {
+				_erase(chunk, i);
+				return;
+			}
+		}
+	}
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+size_t UnrolledDList<ItemType, ChunkCapacity, Allocator>::index(ItemType x, size_t start) const {
+	size_t offset = 0;
+	auto chunk = _find(static_cast<long>(start), offset);
+	auto index = start;
+	while (chunk != nullptr) {
+		auto items = chunk->_items();
+		for (; offset < chunk->_count; ++offset, ++index) {
+			if (items[offset] == x) {
+				return index;
+			}
+		}
+		chunk = chunk->_next;
+		offset = 0;
+	}
+	return -1;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+int UnrolledDList<ItemType, ChunkCapacity, Allocator>::count(ItemType x) const {
+	int count = 0;
+	for (auto chunk = _head; chunk != nullptr; chunk = chunk->_next) {
+		auto items = chunk->_items();
+		for (size_t i = 0; i < chunk->_count; ++i) {
+			if (items[i] == x) {
+				++count;
+			}
+		}
+	}
+	return count;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+void UnrolledDList<ItemType, ChunkCapacity, Allocator>::extend(const UnrolledDList& otherList) {
+	// for self-extension only the items present at the start are appended
+	long n = otherList._size;
+	auto chunk = otherList._head;
+	for (long i = 0; chunk != nullptr && i < n; chunk = chunk->_next) {
+		for (size_t j = 0; j < chunk->_count && i < n; ++j, ++i) {
+			append(chunk->_items()[j]);
+		}
+	}
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+void UnrolledDList<ItemType, ChunkCapacity, Allocator>::_copy(const UnrolledDList& source) {
+	try {
+		for (auto sourceChunk = source._head; sourceChunk != nullptr; sourceChunk = sourceChunk->_next) {
+			auto chunk = _new_chunk(_tail);
+			// on a throw the copies already made in chunk are destroyed and _count stays 0
+			std::uninitialized_copy_n(sourceChunk->_items(), sourceChunk->_count, chunk->_items());
+			chunk->_count = sourceChunk->_count;
+			_size += static_cast<long>(chunk->_count);
+		}
+	}
+	catch (...) {
+		clear();
+		throw;
+	}
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+void UnrolledDList<ItemType, ChunkCapacity, Allocator>::_take(UnrolledDList& source) noexcept {
+	_head = source._head;
+	_tail = source._tail;
+	_size = source._size;
+	_chunkCount = source._chunkCount;
+	source._head = nullptr;
+	source._tail = nullptr;
+	source._size = 0;
+	source._chunkCount = 0;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+typename UnrolledDList<ItemType, ChunkCapacity, Allocator>::_Chunk* UnrolledDList<ItemType, ChunkCapacity, Allocator>::_find(long position, size_t& offset) const {
+	if (position >= _size || position < -_size) {
+		return nullptr;
+	}
+	if (position >= 0) {
+		auto current = _head;
+		while (position >= static_cast<long>(current->_count)) {
+			position -= static_cast<long>(current->_count);
+			current = current->_next;
+		}
+		offset = static_cast<size_t>(position);
+		return current;
+	}
+	else {
+		auto current = _tail;
+		while (-position > static_cast<long>(current->_count)) {
+			position += static_cast<long>(current->_count);
+			current = current->_prev;
+		}
+		offset = static_cast<size_t>(static_cast<long>(current->_count) + position);
+		return current;
+	}
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+typename UnrolledDList<ItemType, ChunkCapacity, Allocator>::_Chunk* UnrolledDList<ItemType, ChunkCapacity, Allocator>::_new_chunk(_Chunk* prev) {
+	_Chunk* chunk = _ChunkTraits::allocate(_alloc, 1);
+	_ChunkTraits::construct(_alloc, chunk);
+	++_chunkCount;
+	chunk->_prev = prev;
+	chunk->_next = prev ? prev->_next : _head;
+	if (chunk->_next) {
+		chunk->_next->_prev = chunk;
+	}
+	else {
+		_tail = chunk;
+	}
+	if (prev) {
+		prev->_next = chunk;
+	}
+	else {
+		_head = chunk;
+	}
+	return chunk;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+void UnrolledDList<ItemType, ChunkCapacity, Allocator>::_delete_chunk(_Chunk* chunk) {
+	if (chunk->_prev) {
+		chunk->_prev->_next = chunk->_next;
+	}
+	else {
+		_head = chunk->_next;
+	}
+	if (chunk->_next) {
+		chunk->_next->_prev = chunk->_prev;
+	}
+	else {
+		_tail = chunk->_prev;
+	}
+	--_chunkCount;
+	_ChunkTraits::destroy(_alloc, chunk);
+	_ChunkTraits::deallocate(_alloc, chunk, 1);
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+void UnrolledDList<ItemType, ChunkCapacity, Allocator>::_split(_Chunk* chunk) {
+	auto upper = _new_chunk(chunk);
+	size_t keep = chunk->_count / 2;
+	size_t moved = chunk->_count - keep;
+	std::uninitialized_move_n(chunk->_items() + keep, moved, upper->_items());
+	std::destroy_n(chunk->_items() + keep, moved);
+	upper->_count = moved;
+	chunk->_count = keep;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+ItemType UnrolledDList<ItemType, ChunkCapacity, Allocator>::_erase(_Chunk* chunk, size_t offset) {
+	auto items = chunk->_items();
+	ItemType item = std::move(items[offset]);
+	std::move(items + offset + 1, items + chunk->_count, items + offset);
+	std::destroy_at(items + chunk->_count - 1);
+	--chunk->_count;
+	--_size;
+
+	if (chunk->_count == 0) {
+		_delete_chunk(chunk);
+		return item;
+	}
+	if (chunk->_count >= ChunkCapacity / 2) {
+		return item;
+	}
+
+	// the headroom keeps an insert right after a merge from splitting the chunk again
+	const size_t mergeLimit = ChunkCapacity - ChunkCapacity / 4;
+	_Chunk* into = nullptr;
+	_Chunk* from = nullptr;
+	if (chunk->_next && chunk->_count + chunk->_next->_count <= mergeLimit) {
+		into = chunk;
+		from = chunk->_next;
+	}
+	else if (chunk->_prev && chunk->_prev->_count + chunk->_count <= mergeLimit) {
+		into = chunk->_prev;
+		from = chunk;
+	}
+	if (into) {
+		std::uninitialized_move_n(from->_items(), from->_count, into->_items() + into->_count);
+		std::destroy_n(from->_items(), from->_count);
+		into->_count += from->_count;
+		from->_count = 0;
+		_delete_chunk(from);
+	}
+	return item;
+}
+
+template <typename ItemType, size_t ChunkCapacity, typename Allocator>
+ItemType UnrolledDList<ItemType, ChunkCapacity, Allocator>::_delete(long position) {
+	// normalize negative indices
+	if (position < 0) position += _size;
+
+	// invalid index -> no exceptions allowed, so return default value
+	if (position < 0 || position >= _size) {
+		return ItemType{};
+	}
+
+	size_t offset = 0;
+	auto chunk = _find(position, offset);
+	return _erase(chunk, offset);
+}
+
+#endif /* UnrolledDList_hpp */
@@ -9,20 +9,41 @@
 // Or, if DList is header-only in your setup, just compile this file.
 //
 // Make sure main.cpp is in the same folder as DList.hpp and DListNode.hpp.
+//
+// Benchmarks are skipped by default; run them with:
+//     ./dlist_tests --bench
 // -----------------------------------------------------------------------------
 
 #include <cassert>
+#include <climits>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "CowDList.hpp"
 #include "DList.hpp"
+#include "DListArena.hpp"
+#include "PooledDList.hpp"
+#include "RopeDList.hpp"
+#include "SkipDList.hpp"
+#include "SmallDList.hpp"
+#include "SoADList.hpp"
+#include "UnrolledDList.hpp"
 
 static const size_t NOT_FOUND = static_cast<size_t>(-1);
 
 // Helper: check that list contents == expected vector
-template <typename ItemType>
-static void expect_contents(const DList<ItemType>& L, const std::vector<ItemType>& v) {
+template <typename ItemType, typename Allocator>
+static void expect_contents(const DList<ItemType, Allocator>& L, const std::vector<ItemType>& v) {
     assert(L.length() == v.size());
     for (size_t i = 0; i < v.size(); ++i) {
         // Only rely on non-negative indexing for operator[] (per docs)
@@ -38,6 +59,19 @@ static DList<ItemType> make_list(std::initializer_list<ItemType> v) {
     return L;
 }
 
+// Helper: allocator that counts the elements it has handed out and not yet taken back
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    long* live;
+    explicit CountingAllocator(long* counter) : live(counter) {}
+    template <typename U> CountingAllocator(const CountingAllocator<U>& other) : live(other.live) {}
+    T* allocate(size_t n) { *live += static_cast<long>(n); return std::allocator<T>().allocate(n); }
+    void deallocate(T* p, size_t n) { *live -= static_cast<long>(n); std::allocator<T>().deallocate(p, n); }
+    template <typename U> bool operator==(const CountingAllocator<U>& other) const { return live == other.live; }
+    template <typename U> bool operator!=(const CountingAllocator<U>& other) const { return live != other.live; }
+};
+
 // -------------------------
 // Tests for DList::DList()
 // -------------------------
@@ -116,6 +150,73 @@ static void test_assignment() {
     assert(D.length() == 0);
 }
 
+// Helper: item whose copy constructor throws once copies_left copies have been made;
+// instances counts the items currently alive
+template <typename ItemType>
+struct ThrowingCopy {
+    ThrowingCopy(ItemType v) : value(v) { ++instances; }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (copies_left-- == 0) throw std::runtime_error("copy failed");
+        ++instances;
+    }
+    ~ThrowingCopy() { --instances; }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    bool operator==(const ThrowingCopy& other) const { return value == other.value; }
+
+    ItemType value;
+    static inline long copies_left = -1; // negative: never throw
+    static inline long instances = 0;
+};
+
+// ------------------------------------------------
+// Tests for DList copy when an item copy throws
+// ------------------------------------------------
+// Edge cases covered:
+//  - Copy constructor frees every node copied before the throw (no leak)
+//  - operator= leaves the target empty, consistent and usable
+//  - The source is unchanged
+template <typename ItemType>
+static void test_copy_throwing() {
+    std::cout << "[DList copy] item copy throws\n";
+    using Item = ThrowingCopy<ItemType>;
+    DList<Item> a;
+    for (int i = 0; i < 5; ++i) a.append(Item(static_cast<ItemType>(i)));
+
+    Item::copies_left = 2; // the third copy throws
+    bool threw = false;
+    try {
+        DList<Item> b(a);
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    Item::copies_left = -1;
+    DList<Item> c;
+    c.append(Item(static_cast<ItemType>(9)));
+    c.append(Item(static_cast<ItemType>(8)));
+    Item::copies_left = 2;
+    threw = false;
+    try {
+        c = a;
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    Item::copies_left = -1;
+    assert(threw);
+    assert(c.length() == 0);
+    c.append(Item(static_cast<ItemType>(7)));
+    c.insert(0, Item(static_cast<ItemType>(6)));
+    assert(c.length() == 2 && c[0].value == 6 && c[-1].value == 7);
+
+    assert(a.length() == 5);
+    for (long i = 0; i < 5; ++i) assert(a[i].value == static_cast<ItemType>(i));
+    c = a;
+    assert(c.length() == 5 && c[4].value == 4);
+}
+
 // ------------------------------------
 // Tests for DList::append(const T& x)
 // ------------------------------------
@@ -342,6 +443,1525 @@ static void test_extend() {
 	expect_contents(G, { 1, 2, 3, 4, 1, 2, 3, 4});
 }
 
+// --------------------------------------------------------
+// Tests for the DList finger (operator[] remembers position)
+// --------------------------------------------------------
+// Edge cases covered:
+//  - Forward and backward index sweeps return the right items
+//  - insert before / after the finger shifts or keeps its index
+//  - pop and remove of the finger node, and of nodes before it
+//  - clear() forgets the finger
+template <typename ItemType>
+static void test_finger() {
+    std::cout << "[DList::operator[]] finger across mutations\n";
+    DList<ItemType> L;
+    for (int i = 0; i < 100; ++i) L.append(i);
+    for (long i = 0; i < 100; ++i) assert(L[i] == i);
+    for (long i = 99; i >= 0; --i) assert(L[i] == i);
+
+    assert(L[50] == 50);
+    L.insert(10, -1);           // before the finger
+    assert(L[51] == 50 && L[50] == 49);
+    L.insert(60, -2);           // after the finger
+    assert(L[51] == 50 && L[60] == -2 && L[61] == 59);
+
+    assert(L[51] == 50);
+    assert(L.pop(51) == 50);    // the finger node itself
+    assert(L[51] == 51 && L[50] == 49);
+    L.remove(-1);               // before the finger
+    assert(L[50] == 51 && L[10] == 10);
+    assert(L.pop(0) == 0);
+    assert(L[-1] == 99 && L[0] == 1 && L.pop() == 99);
+    assert(L[L.length() - 1] == 98);
+
+    L.clear();
+    L.append(7);
+    assert(L[0] == 7);
+}
+
+// --------------------------------------
+// Tests for the DList position directory
+// --------------------------------------
+// Edge cases covered:
+//  - Random lookups agree with a vector while insert/pop/remove shift the entries
+//  - Pops of entry nodes and of the tail
+//  - The directory is rebuilt lazily after a burst of mutations
+//  - Queue use near the ends never rebuilds it
+//  - clear() and copies start without one
+template <typename ItemType>
+static void test_directory() {
+    std::cout << "[DList::operator[]] position directory\n";
+    // every value is distinct so remove() and the vector agree on which one goes
+    const long n = 4096;
+    DList<ItemType> L;
+    std::vector<ItemType> v;
+    for (long i = 0; i < n; ++i) { L.append(i); v.push_back(i); }
+    assert(L.stats().directory_entries == 0);
+
+    assert(L[n / 2] == n / 2);
+    auto built = L.stats();
+    assert(built.directory_rebuilds == 1 && built.directory_rebuild_steps == n);
+    assert(built.directory_entries == 64);
+
+    std::mt19937 rng(99);
+    for (int step = 0; step < 3000; ++step) {
+        long size = static_cast<long>(v.size());
+        long pos = std::uniform_int_distribution<long>(0, size - 1)(rng);
+        switch (step % 5) {
+        case 0:
+            L.insert(pos, -step - 1);
+            v.insert(v.begin() + pos, -step - 1);
+            break;
+        case 1:
+            pos -= pos % 64;    // often a node the directory points at
+            assert(L.pop(pos) == v[pos]);
+            v.erase(v.begin() + pos);
+            break;
+        case 2:
+            assert(L.pop() == v.back());
+            v.pop_back();
+            L.append(n + step);
+            v.push_back(n + step);
+            break;
+        case 3:
+            L.remove(v[pos]);
+            v.erase(v.begin() + pos);
+            L.insert(0, n + step);
+            v.insert(v.begin(), n + step);
+            break;
+        default:
+            break;
+        }
+        for (int k = 0; k < 3; ++k) {
+            long at = std::uniform_int_distribution<long>(0, static_cast<long>(v.size()) - 1)(rng);
+            assert(L[at] == v[at]);
+        }
+    }
+    expect_contents(L, v);
+    auto after = L.stats();
+    assert(after.directory_rebuilds > 1 && after.directory_rebuilds < 3000 / 32);
+
+    // a queue touches only the ends and leaves the dropped directory alone
+    for (long i = 0; i < 1000; ++i) {
+        L.append(L.pop(0));
+        assert(L[-1] == L[L.length() - 1] && L[1] == L[-static_cast<long>(L.length()) + 1]);
+    }
+    assert(L.stats().directory_rebuilds == after.directory_rebuilds);
+    assert(L.stats().directory_entries == 0);
+
+    DList<ItemType> copy(L);
+    assert(copy.stats().directory_entries == 0 && copy.stats().directory_rebuilds == 0);
+    assert(copy[n / 3] == L[n / 3]);
+    L.clear();
+    assert(L.stats().directory_entries == 0 && L.stats().bytes_used >= sizeof(L));
+    L.append(5);
+    assert(L[0] == 5);
+}
+
+// ------------------------------------------------
+// Tests for const DList members on several threads
+// ------------------------------------------------
+// Edge cases covered:
+//  - Threads sweeping, searching, slicing and batch-reading one const list at once
+//    all see the right items, whether or not they get to use the finger
+//  - stats() and bytes_used() can be read while lookups run
+//  - The finger and the directory still work for later lookups
+template <typename ItemType>
+static void test_const_threads() {
+    std::cout << "[DList const members] lookups on several threads\n";
+    const long n = 3000;
+    DList<ItemType> L;
+    for (long i = 0; i < n; ++i) L.append(static_cast<ItemType>(i));
+    const DList<ItemType>& view = L;
+
+    std::vector<std::thread> threads;
+    std::vector<int> ok(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&view, &ok, t, n] {
+            bool good = true;
+            for (int round = 0; round < 3; ++round) {
+                for (long i = t; i < n; i += 3) good = good && view[i] == static_cast<ItemType>(i);
+                for (long i = n - 1 - t; i >= 0; i -= 5) good = good && view[i - n] == static_cast<ItemType>(i);
+                good = good && view.index(static_cast<ItemType>(n - 1 - t)) == static_cast<size_t>(n - 1 - t);
+                auto part = view.slice(t, n, 7);
+                good = good && part.length() == static_cast<size_t>((n - t + 6) / 7) && part[1] == static_cast<ItemType>(t + 7);
+                auto items = view.get_many({n - 1, static_cast<long>(t), n / 2, -2});
+                good = good && items == std::vector<ItemType>{static_cast<ItemType>(n - 1), static_cast<ItemType>(t),
+                                                              static_cast<ItemType>(n / 2), static_cast<ItemType>(n - 2)};
+                good = good && view.stats().live_nodes == static_cast<size_t>(n) && view.bytes_used() > sizeof(view);
+            }
+            ok[t] = good;
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int good : ok) assert(good);
+    for (long i = 0; i < n; i += 11) assert(L[i] == static_cast<ItemType>(i));
+    assert(L.stats().directory_entries > 0);
+}
+
+// ------------------------------------
+// Tests for DList::get_many / set_many
+// ------------------------------------
+// Edge cases covered:
+//  - Results follow the caller's order for unsorted, negative and repeated indices
+//  - Out-of-range indices give ItemType{} or are skipped
+//  - A repeated index in set_many keeps the last value
+//  - Empty inputs and an empty list
+template <typename ItemType>
+static void test_get_set_many() {
+    std::cout << "[DList::get_many/set_many] batched lookups\n";
+    DList<ItemType> L;
+    assert(L.get_many({0, -1}) == std::vector<ItemType>({0, 0}));
+    L.set_many({0}, {1});
+    assert(L.length() == 0);
+
+    for (int i = 0; i < 2000; ++i) L.append(i * 10);
+    assert(L.get_many({}).empty());
+    auto got = L.get_many({1500, 3, -1, 2000, 3, -2000, -2001, 999});
+    assert(got == std::vector<ItemType>({15000, 30, 19990, 0, 30, 0, 0, 9990}));
+
+    L.set_many({-1, 5, 2000, 5, -2001, 0}, {-1, -5, 7, -55, 7, -100, 123});
+    assert(L[-1] == -1 && L[5] == -55 && L[0] == -100 && L[4] == 40 && L[6] == 60);
+    assert(L.length() == 2000);
+
+    std::mt19937 rng(5);
+    std::vector<long> positions;
+    for (int i = 0; i < 500; ++i) positions.push_back(std::uniform_int_distribution<long>(-2000, 1999)(rng));
+    got = L.get_many(positions);
+    for (size_t i = 0; i < positions.size(); ++i) assert(got[i] == L[positions[i]]);
+}
+
+// ----------------------------
+// Tests for DList::insert_many
+// ----------------------------
+// Edge cases covered:
+//  - Matches inserting the pairs one after another
+//  - Positions at the front, the back, in the middle, negative, and beyond either end
+//  - An empty batch, and a batch into an empty list
+//  - Later operations still find the right nodes
+//  - The batch's nodes are reserved up front: cached nodes are used first and no
+//    spare nodes are left behind
+//  - A copy that throws leaves the list unchanged and its cache within the limit
+template <typename ItemType>
+static void test_insert_many() {
+    std::cout << "[DList::insert_many] bulk insert\n";
+    DList<ItemType> L;
+    L.insert_many({});
+    assert(L.length() == 0);
+    L.insert_many({{5, 1}, {-9, 2}, {1, 3}, {-1, 4}});
+    expect_contents(L, {2, 3, 4, 1});
+
+    std::mt19937 rng(16);
+    std::vector<ItemType> v(L.length());
+    for (long i = 0; i < static_cast<long>(v.size()); ++i) v[i] = L[i];
+    for (int round = 0; round < 30; ++round) {
+        std::vector<std::pair<long, ItemType>> batch;
+        int k = std::uniform_int_distribution<int>(1, 200)(rng);
+        for (int j = 0; j < k; ++j) {
+            long size = static_cast<long>(v.size());
+            long position = std::uniform_int_distribution<long>(-size - 3, size + 3)(rng);
+            ItemType value = round * 1000 + j;
+            batch.emplace_back(position, value);
+            long at = position < 0 ? position + size : position;
+            at = at < 0 ? 0 : (at > size ? size : at);
+            v.insert(v.begin() + at, value);
+        }
+        L.insert_many(batch);
+        expect_contents(L, v);
+        for (long i = static_cast<long>(v.size()) - 1; i >= 0; --i) assert(L[i] == v[i]); // _prev links
+    }
+    assert(L[-1] == v.back() && L.pop(v.size() / 2) == v[v.size() / 2]);
+
+    DList<ItemType> R;
+    for (int i = 0; i < 10; ++i) R.append(i);
+    for (int i = 0; i < 4; ++i) R.pop();
+    std::vector<std::pair<long, ItemType>> batch;
+    for (int j = 0; j < 100; ++j) batch.emplace_back(j % 7, j);
+    R.insert_many(batch);
+    DListStats st = R.stats();
+    assert(R.length() == 106 && st.cached_nodes == 0 && st.allocations == 106);
+
+    using Item = ThrowingCopy<ItemType>;
+    DList<Item> T;
+    T.append(Item(1));
+    std::vector<std::pair<long, Item>> items;
+    for (int j = 0; j < 200; ++j) items.emplace_back(0, Item(static_cast<ItemType>(j)));
+    Item::copies_left = 150;
+    bool threw = false;
+    try {
+        T.insert_many(items);
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    Item::copies_left = -1;
+    st = T.stats();
+    assert(threw && T.length() == 1 && T[0] == Item(1));
+    assert(st.cached_nodes <= DList<Item>::default_node_cache_limit);
+    assert(st.allocations - st.deallocations == st.live_nodes + st.cached_nodes);
+}
+
+// ---------------------------------------
+// Tests for DList::delete_many / pop_many
+// ---------------------------------------
+// Edge cases covered:
+//  - Unsorted, negative, repeated and out-of-range indices
+//  - The head, the tail, and every index
+//  - An empty set and an empty list
+//  - Links stay consistent in both directions
+template <typename ItemType>
+static void test_delete_many() {
+    std::cout << "[DList::delete_many/pop_many] bulk removal\n";
+    DList<ItemType> L;
+    assert(L.delete_many({0, -1}) == 0 && L.pop_many({3}).empty());
+
+    for (int i = 0; i < 10; ++i) L.append(i);
+    assert(L.delete_many({}) == 0 && L.length() == 10);
+    assert(L.pop_many({-1, 3, 0, 3, -7, 10, -11}) == std::vector<ItemType>({0, 3, 9}));
+    expect_contents(L, {1, 2, 4, 5, 6, 7, 8});
+    assert(L[-1] == 8 && L[-7] == 1);
+    assert(L.delete_many({0, 1, 2, 3, 4, 5, 6}) == 7 && L.length() == 0);
+    L.append(1);
+    expect_contents(L, {1});
+
+    std::mt19937 rng(17);
+    std::vector<ItemType> v;
+    L.clear();
+    for (int i = 0; i < 3000; ++i) { L.append(i); v.push_back(i); }
+    while (v.size() > 50) {
+        long size = static_cast<long>(v.size());
+        std::vector<long> positions;
+        std::vector<bool> gone(v.size());
+        for (int j = 0; j < 40; ++j) {
+            long p = std::uniform_int_distribution<long>(-size, size - 1)(rng);
+            positions.push_back(p);
+            gone[p < 0 ? p + size : p] = true;
+        }
+        std::vector<ItemType> kept, popped;
+        for (size_t i = 0; i < v.size(); ++i) (gone[i] ? popped : kept).push_back(v[i]);
+        assert(L.pop_many(positions) == popped);
+        v = kept;
+        expect_contents(L, v);
+        for (long i = size - 1 - static_cast<long>(popped.size()); i >= 0; --i) assert(L[i] == v[i]);
+    }
+}
+
+// -----------------------------------------
+// Tests for DList::slice(start, stop, step)
+// -----------------------------------------
+// Edge cases covered:
+//  - Python's normalization of negative and out-of-range bounds, for positive and negative steps
+//  - Omitted bounds given as LONG_MAX/LONG_MIN
+//  - Empty slices, step 0, and steps longer than the list
+//  - An empty source and a long reversed stride
+//  - The result's nodes are allocated up front, one per item, with none left cached
+template <typename ItemType>
+static void test_slice() {
+    std::cout << "[DList::slice] Python slicing\n";
+    DList<ItemType> L;
+    expect_contents(L.slice(0), {});
+    expect_contents(L.slice(LONG_MAX, LONG_MIN, -1), {});
+    for (int i = 0; i < 10; ++i) L.append(i);
+
+    // expected values are Python's a[start:stop:step] for a = list(range(10))
+    expect_contents(L.slice(0, 10, 1), {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    expect_contents(L.slice(2, 8, 3), {2, 5});
+    expect_contents(L.slice(-3), {7, 8, 9});
+    expect_contents(L.slice(-100, 100), {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    expect_contents(L.slice(8, 2, -1), {8, 7, 6, 5, 4, 3});
+    expect_contents(L.slice(LONG_MAX, LONG_MIN, -1), {9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+    expect_contents(L.slice(LONG_MAX, LONG_MIN, -3), {9, 6, 3, 0});
+    expect_contents(L.slice(-1, -4, -1), {9, 8, 7});
+    expect_contents(L.slice(5, 5), {});
+    expect_contents(L.slice(7, 3), {});
+    expect_contents(L.slice(3, 7, -1), {});
+    expect_contents(L.slice(-2, -20, -4), {8, 4, 0});
+    expect_contents(L.slice(1, LONG_MAX, 20), {1});
+    expect_contents(L.slice(9, 0, -100), {9});
+    expect_contents(L.slice(0, 10, 0), {});
+    expect_contents(L.slice(LONG_MAX, LONG_MIN, LONG_MIN), {9});
+    expect_contents(L, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+    DList<ItemType> big;
+    std::vector<ItemType> expected;
+    for (int i = 0; i < 5000; ++i) big.append(i);
+    for (int i = 4999 - 3; i >= 0; i -= 7) expected.push_back(i);
+    expect_contents(big.slice(-4, LONG_MIN, -7), expected);
+    DListStats st = big.slice(-4, LONG_MIN, -7).stats();
+    assert(st.allocations == expected.size() && st.cached_nodes == 0);
+}
+
+// --------------------------------------------
+// Tests for DList::assign_slice / delete_slice
+// --------------------------------------------
+// Edge cases covered:
+//  - Contiguous ranges that grow, shrink, vanish or insert (stop before start)
+//  - Extended slices with positive and negative steps
+//  - A length mismatch and step 0 leave the list unchanged
+//  - Assigning a list to a slice of itself
+//  - A long list where the relinked range sits far from both ends
+template <typename ItemType>
+static void test_slice_assign_delete() {
+    std::cout << "[DList::assign_slice/delete_slice] slice mutation\n";
+    DList<ItemType> L;
+    auto reset = [&L]() {
+        L.clear();
+        for (int i = 0; i < 10; ++i) L.append(i);
+    };
+
+    // expected values are Python's results on a = list(range(10))
+    reset(); L.assign_slice(2, 5, 1, make_list<ItemType>({-1}));
+    expect_contents(L, {0, 1, -1, 5, 6, 7, 8, 9});
+    reset(); L.assign_slice(2, 5, 1, make_list<ItemType>({}));
+    expect_contents(L, {0, 1, 5, 6, 7, 8, 9});
+    reset(); L.assign_slice(7, 3, 1, make_list<ItemType>({-1, -2}));
+    expect_contents(L, {0, 1, 2, 3, 4, 5, 6, -1, -2, 7, 8, 9});
+    reset(); L.assign_slice(-2, LONG_MAX, 1, make_list<ItemType>({-1, -2, -3}));
+    expect_contents(L, {0, 1, 2, 3, 4, 5, 6, 7, -1, -2, -3});
+    reset(); L.assign_slice(LONG_MAX, LONG_MIN, -1, make_list<ItemType>({10, 11, 12, 13, 14, 15, 16, 17, 18, 19}));
+    expect_contents(L, {19, 18, 17, 16, 15, 14, 13, 12, 11, 10});
+    reset(); L.assign_slice(1, 8, 3, make_list<ItemType>({-1, -2, -3}));
+    expect_contents(L, {0, -1, 2, 3, -2, 5, 6, -3, 8, 9});
+    reset(); L.assign_slice(8, LONG_MIN, -4, make_list<ItemType>({-1, -2, -3}));
+    expect_contents(L, {-3, 1, 2, 3, -2, 5, 6, 7, -1, 9});
+    reset(); L.assign_slice(LONG_MAX, LONG_MIN, 1, make_list<ItemType>({-1}));
+    expect_contents(L, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1});
+    reset(); L.assign_slice(LONG_MIN, LONG_MAX, 1, make_list<ItemType>({-1}));
+    expect_contents(L, {-1});
+    reset(); L.assign_slice(1, 8, 3, make_list<ItemType>({-1, -2}));
+    expect_contents(L, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    reset(); assert(L.delete_slice(2, 5, 1) == 3);
+    expect_contents(L, {0, 1, 5, 6, 7, 8, 9});
+    reset(); assert(L.delete_slice(-3, LONG_MAX, 1) == 3);
+    expect_contents(L, {0, 1, 2, 3, 4, 5, 6});
+    reset(); assert(L.delete_slice(LONG_MAX, LONG_MIN, -2) == 5);
+    expect_contents(L, {0, 2, 4, 6, 8});
+    reset(); assert(L.delete_slice(1, 9, 3) == 3);
+    expect_contents(L, {0, 2, 3, 5, 6, 8, 9});
+    reset(); assert(L.delete_slice(8, 1, -3) == 3);
+    expect_contents(L, {0, 1, 3, 4, 6, 7, 9});
+    reset(); assert(L.delete_slice(5, 2, 1) == 0);
+    expect_contents(L, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    reset(); assert(L.delete_slice(LONG_MIN, LONG_MAX, 1) == 10);
+    expect_contents(L, {});
+    reset(); L.assign_slice(0, 5, 0, make_list<ItemType>({-1}));
+    assert(L.delete_slice(0, 5, 0) == 0);
+    expect_contents(L, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+    reset(); L.assign_slice(1, 3, 1, L);
+    expect_contents(L, {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 3, 4, 5, 6, 7, 8, 9});
+    reset(); L.assign_slice(LONG_MAX, LONG_MIN, -1, L);
+    expect_contents(L, {9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+    for (long i = 9; i >= 0; --i) assert(L[i] == 9 - i);
+
+    DList<ItemType> big;
+    std::vector<ItemType> v;
+    for (int i = 0; i < 5000; ++i) { big.append(i); v.push_back(i); }
+    big.assign_slice(2000, 2600, 1, make_list<ItemType>({-1, -2}));
+    v.erase(v.begin() + 2000, v.begin() + 2600);
+    v.insert(v.begin() + 2000, {-1, -2});
+    expect_contents(big, v);
+    assert(big.delete_slice(-1000, -10) == 990);
+    v.erase(v.end() - 1000, v.end() - 10);
+    expect_contents(big, v);
+    for (long i = static_cast<long>(v.size()) - 1; i >= 0; --i) assert(big[i] == v[i]);
+}
+
+// ----------------------------------------------------------
+// Tests for DList move construction / move assignment / swap
+// ----------------------------------------------------------
+// Edge cases covered:
+//  - Contents, node cache and counters change hands without copying
+//  - The source is left empty but usable
+//  - Self-move
+//  - Moving between pmr lists on different resources copies instead
+//  - Lists in a vector keep their nodes when the vector reallocates
+template <typename ItemType>
+static void test_move() {
+    std::cout << "[DList] move and swap\n";
+    static_assert(std::is_nothrow_move_constructible<DList<ItemType>>::value, "move must not throw");
+    static_assert(std::is_nothrow_move_assignable<DList<ItemType>>::value, "move must not throw");
+
+    DList<ItemType> a = make_list<ItemType>({1, 2, 3, 4});
+    a.pop();
+    auto before = a.stats();
+    DList<ItemType> b(std::move(a));
+    expect_contents(b, {1, 2, 3});
+    expect_contents(a, {});
+    assert(b.stats().allocations == before.allocations && b.cached_nodes() == 1);
+    assert(a.stats().allocations == 0 && a.cached_nodes() == 0);
+    a.append(9);
+    expect_contents(a, {9});
+
+    a = std::move(b);
+    expect_contents(a, {1, 2, 3});
+    expect_contents(b, {});
+    a = std::move(a);
+    expect_contents(a, {1, 2, 3});
+
+    b.append(7);
+    a.swap(b);
+    expect_contents(a, {7});
+    expect_contents(b, {1, 2, 3});
+    swap(a, b);
+    expect_contents(a, {1, 2, 3});
+    assert(a[1] == 2 && a[-1] == 3);
+
+    std::vector<DList<ItemType>> lists;
+    for (int i = 0; i < 100; ++i) {
+        lists.emplace_back();
+        for (int j = 0; j <= i; ++j) lists.back().append(j);
+    }
+    for (int i = 0; i < 100; ++i) {
+        assert(lists[i].length() == static_cast<size_t>(i + 1) && lists[i][-1] == i);
+        assert(lists[i].stats().allocations == static_cast<unsigned long long>(i + 1));
+    }
+
+    std::pmr::monotonic_buffer_resource one, two;
+    pmr::DList<ItemType> p(&one), q(&two);
+    p.append(5);
+    q.append(6);
+    q = std::move(p);
+    assert(q.get_allocator().resource() == &two && p.length() == 0);
+    expect_contents(q, {5});
+    pmr::DList<ItemType> r(std::move(q));
+    assert(r.get_allocator().resource() == &two && q.length() == 0);
+    expect_contents(r, {5});
+    pmr::DList<ItemType> copied(&one);
+    copied = r;
+    assert(copied.get_allocator().resource() == &one);
+    expect_contents(copied, {5});
+}
+
+// Helper: item type without a default constructor, built from two arguments
+struct Labelled {
+    explicit Labelled(const std::string& name, int copies) : text(copies, name[0]) {}
+    std::string text;
+};
+
+// -----------------------------------------------------------------
+// Tests for DList rvalue append / insert and emplace_back / emplace
+// -----------------------------------------------------------------
+// Edge cases covered:
+//  - Moved-from arguments
+//  - Items built in place from constructor arguments (front, middle, end, clamped)
+//  - Returned references
+//  - pop moves the item out
+//  - An ItemType without a default constructor
+template <typename ItemType>
+static void test_emplace() {
+    std::cout << "[DList::emplace] in-place and move insertion\n";
+    DList<ItemType> L;
+    ItemType first = "a string long enough to live on the heap";
+    L.append(std::move(first));
+    assert(first.empty() && L[0] == "a string long enough to live on the heap");
+    ItemType second = "another string long enough to live on the heap";
+    L.insert(0, std::move(second));
+    assert(second.empty() && L[0] == "another string long enough to live on the heap");
+
+    L.clear();
+    assert(L.emplace_back(3, 'x') == "xxx");
+    L.emplace(0, 2, 'a');
+    L.emplace(-1, "mid");
+    L.emplace(100, 1, 'z');
+    L.emplace(-100, "front");
+    L.emplace_back() += "tail";
+    expect_contents(L, {"front", "aa", "mid", "xxx", "z", "tail"});
+    L.emplace(2, "c-string", 3) = "changed";
+    assert(L[2] == "changed");
+    assert(L.pop(1) == "aa" && L.length() == 6);
+
+    DList<Labelled> labels;
+    labels.emplace_back("b", 2);
+    labels.emplace(0, "a", 1);
+    labels.append(Labelled("c", 3));
+    labels.insert(-1, Labelled("d", 1));
+    assert(labels.length() == 4 && labels[0].text == "a" && labels[1].text == "bb");
+    assert(labels[2].text == "d" && labels[3].text == "ccc");
+}
+
+// -----------------------------------------
+// Tests for DList::extend(DList&&) / splice
+// -----------------------------------------
+// Edge cases covered:
+//  - Consuming extend relinks nodes without allocating and leaves the source empty and usable
+//  - Splice of a middle range, a whole list and an empty range
+//  - Clamped and negative positions
+//  - Moving a range within one list in both directions and onto itself
+//  - Self-extension
+//  - pmr lists on different resources move the items into new nodes instead
+template <typename ItemType>
+static void test_splice() {
+    std::cout << "[DList::splice] relinking between lists\n";
+    DList<ItemType> a = make_list<ItemType>({1, 2});
+    DList<ItemType> b = make_list<ItemType>({3, 4, 5});
+    auto allocations = a.stats().allocations + b.stats().allocations;
+    a.extend(std::move(b));
+    expect_contents(a, {1, 2, 3, 4, 5});
+    expect_contents(b, {});
+    assert(a.stats().allocations + b.stats().allocations == allocations); // counts moved, none made
+    b.append(6);
+    a.extend(std::move(b));
+    a.extend(DList<ItemType>());
+    expect_contents(a, {1, 2, 3, 4, 5, 6});
+    for (long i = 5; i >= 0; --i) assert(a[i] == i + 1);
+    a.extend(std::move(a));
+    expect_contents(a, {1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5, 6});
+
+    a = make_list<ItemType>({1, 2, 3});
+    b = make_list<ItemType>({10, 11, 12, 13, 14});
+    a.splice(1, b, 1, 4);
+    expect_contents(a, {1, 11, 12, 13, 2, 3});
+    expect_contents(b, {10, 14});
+    a.splice(100, b, -1);
+    a.splice(-100, b, 0, 1);
+    expect_contents(a, {10, 1, 11, 12, 13, 2, 3, 14});
+    expect_contents(b, {});
+    a.splice(0, b, 0);
+    a.splice(2, a, 5, 5);
+    expect_contents(a, {10, 1, 11, 12, 13, 2, 3, 14});
+
+    a.splice(0, a, -2);                 // later range to the front
+    expect_contents(a, {3, 14, 10, 1, 11, 12, 13, 2});
+    a.splice(LONG_MAX, a, 0, 2);        // front range to the end
+    expect_contents(a, {10, 1, 11, 12, 13, 2, 3, 14});
+    a.splice(3, a, 2, 5);               // inside its own range
+    a.splice(5, a, 2, 5);               // right after its own range
+    expect_contents(a, {10, 1, 11, 12, 13, 2, 3, 14});
+    for (long i = 7; i >= 0; --i) assert(a[i] == std::vector<ItemType>({10, 1, 11, 12, 13, 2, 3, 14})[i]);
+
+    std::pmr::monotonic_buffer_resource one, two;
+    pmr::DList<ItemType> p(&one), q(&two);
+    for (int i = 0; i < 4; ++i) { p.append(i); q.append(10 + i); }
+    p.splice(2, q, 1, 3);
+    expect_contents(p, {0, 1, 11, 12, 2, 3});
+    expect_contents(q, {10, 13});
+    p.extend(std::move(q));
+    expect_contents(p, {0, 1, 11, 12, 2, 3, 10, 13});
+    assert(q.length() == 0 && p.get_allocator().resource() == &one);
+}
+
+// ----------------------------------------------------------------------
+// Tests for DList node handles (extract, insert / append of a node_type)
+// ----------------------------------------------------------------------
+// Edge cases covered:
+//  - extract from the front, middle, back and by negative index
+//  - An invalid index gives an empty handle
+//  - insert and append of a handle move the node without any allocation or copy
+//  - An empty handle inserts nothing
+//  - A handle dropped unused frees its node
+//  - Handles move between lists on different pmr resources by moving the item
+template <typename ItemType>
+static void test_node_handle() {
+    std::cout << "[DList::extract] node handles\n";
+    long live = 0;
+    using Alloc = CountingAllocator<ItemType>;
+    DList<ItemType, Alloc> a{Alloc(&live)}, b{Alloc(&live)};
+    a.set_node_cache_limit(0);
+    b.set_node_cache_limit(0);
+    for (int i = 0; i < 5; ++i) a.append(i);
+    assert(live == 5);
+
+    auto empty = a.extract(5);
+    assert(empty.empty() && !empty && a.extract(-6).empty());
+    auto middle = a.extract(2);
+    assert(!middle.empty() && middle.value() == 2 && live == 5 && a.length() == 4);
+    auto back = a.extract(-1);
+    b.append(std::move(middle));
+    b.insert(0, std::move(back));
+    b.insert(100, a.extract(0));
+    b.insert(1, std::move(empty));
+    assert(middle.empty() && back.empty() && live == 5);
+    expect_contents(a, {1, 3});
+    expect_contents(b, {4, 2, 0});
+    assert(b[-1] == 0 && b[0] == 4);
+
+    auto moved = b.extract(1);
+    auto target = std::move(moved);
+    assert(moved.empty() && target.value() == 2);
+    target.value() = 20;
+    a.insert(1, std::move(target));
+    expect_contents(a, {1, 20, 3});
+    {
+        auto dropped = a.extract(0);
+        assert(live == 5);
+    }
+    assert(live == 4);
+
+    std::pmr::monotonic_buffer_resource one, two;
+    pmr::DList<ItemType> p(&one), q(&two);
+    p.append(7);
+    q.append(p.extract(0));
+    assert(p.length() == 0 && q.length() == 1 && q[0] == 7);
+}
+
+// ------------------------------------------
+// Tests for DList::clear / ~DList on long lists
+// ------------------------------------------
+// Edge cases covered:
+//  - clear() on a list far longer than a recursive teardown could survive
+//  - destructor of an equally long list
+//  - list remains usable after clearing a long list
+template <typename ItemType>
+static void test_clear_long() {
+    std::cout << "[DList::clear] long list teardown is iterative\n";
+    const long n = 1000000;
+    DList<ItemType> L;
+    for (long i = 0; i < n; ++i) L.append(static_cast<ItemType>(i));
+    assert(L.length() == static_cast<size_t>(n));
+    L.clear();
+    assert(L.length() == 0);
+    L.append(1);
+    expect_contents(L, {1});
+
+    {
+        DList<ItemType> D;
+        for (long i = 0; i < n; ++i) D.append(static_cast<ItemType>(i));
+    } // destructor runs here
+}
+
+// ------------------------------------------------
+// Tests for DList<ItemType, Allocator> / pmr::DList
+// ------------------------------------------------
+// Edge cases covered:
+//  - Every node allocation and deallocation goes through the supplied allocator
+//  - Copies use the allocator of the source (select_on_container_copy_construction)
+//  - pmr::DList backed by monotonic_buffer_resource and unsynchronized_pool_resource
+//  - pmr::DList copy assignment keeps the target's resource
+template <typename ItemType>
+static void test_allocator() {
+    std::cout << "[DList<ItemType, Allocator>] custom and pmr allocators\n";
+    long live = 0;
+    {
+        DList<ItemType, CountingAllocator<ItemType>> L{CountingAllocator<ItemType>(&live)};
+        L.set_node_cache_limit(0); // count only live nodes
+        L.append(1);
+        L.append(2);
+        L.insert(0, 0);
+        assert(live == 3);
+        expect_contents(L, {0,1,2});
+        auto C(L);
+        assert(live == 6);
+        assert(C.get_allocator() == L.get_allocator());
+        C.pop(0);
+        C.remove(2);
+        assert(live == 4);
+        L.clear();
+        assert(live == 1);
+    }
+    assert(live == 0);
+
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+    pmr::DList<ItemType> M(&arena);
+    for (int i = 0; i < 10; ++i) M.append(i);
+    M.insert(5, 50);
+    assert(M.pop() == 9);
+    expect_contents(M, {0,1,2,3,4,50,5,6,7,8});
+    assert(M.get_allocator().resource() == &arena);
+
+    std::pmr::unsynchronized_pool_resource pool;
+    pmr::DList<ItemType> P(&pool);
+    P.extend(M);
+    pmr::DList<ItemType> Q(P);  // copy falls back to the default resource
+    expect_contents(Q, {0,1,2,3,4,50,5,6,7,8});
+    assert(P.get_allocator().resource() == &pool);
+
+    // copy assignment keeps the target's resource (pmr allocators do not propagate)
+    pmr::DList<ItemType> R(&pool);
+    R.append(99);
+    R = M;
+    expect_contents(R, {0,1,2,3,4,50,5,6,7,8});
+    assert(R.get_allocator().resource() == &pool);
+    M = R;
+    assert(M.get_allocator().resource() == &arena);
+}
+
+// ---------------------------------------------------------------
+// Tests for the DList node cache (set_node_cache_limit, shrink_to_fit)
+// ---------------------------------------------------------------
+// Edge cases covered:
+//  - pop(0)/append cycles reuse retired nodes and allocate nothing
+//  - the cache never grows past its high-water mark
+//  - lowering the limit and shrink_to_fit() release cached nodes
+//  - a limit of 0 disables recycling
+template <typename ItemType>
+static void test_node_cache() {
+    std::cout << "[DList::set_node_cache_limit/shrink_to_fit] node recycling\n";
+    long live = 0;
+    {
+        DList<ItemType, CountingAllocator<ItemType>> L{CountingAllocator<ItemType>(&live)};
+        assert(L.node_cache_limit() == DList<ItemType>::default_node_cache_limit);
+        for (int i = 0; i < 8; ++i) L.append(i);
+        assert(live == 8);
+
+        // steady-state queue: no allocation
+        for (int i = 8; i < 1000; ++i) {
+            assert(L.pop(0) == i - 8);
+            L.append(i);
+            L.remove(i - 7);
+            L.insert(0, i - 7);
+        }
+        assert(live == 8);
+        assert(L.cached_nodes() == 0);
+
+        L.set_node_cache_limit(4);
+        L.clear();
+        assert(L.cached_nodes() == 4);
+        assert(live == 4);
+        for (int i = 0; i < 4; ++i) L.append(i);
+        assert(live == 4 && L.cached_nodes() == 0);
+        expect_contents(L, {0,1,2,3});
+
+        L.clear();
+        L.shrink_to_fit();
+        assert(L.cached_nodes() == 0 && live == 0);
+
+        L.set_node_cache_limit(0);
+        L.append(1);
+        L.pop();
+        assert(L.cached_nodes() == 0 && live == 0);
+    }
+    assert(live == 0);
+}
+
+// ---------------------------------------------------------------
+// Tests for DList::stats / bytes_used / node_overhead
+// ---------------------------------------------------------------
+// Edge cases covered:
+//  - Empty list uses only the list object and has made no allocations
+//  - Counters track allocations, cache reuse and releases
+//  - payload + structural bytes add up to bytes_used
+//  - Nodes moved by splice, extend(DList&&), extract and insert(node_type) take their
+//    allocation count along, so allocations - deallocations stays live + cached per list
+//  - bytes_used of every backend grows with the number of items
+template <typename ItemType>
+static void test_memory_accounting() {
+    std::cout << "[DList::stats] memory accounting\n";
+    DList<ItemType> L;
+    DListStats st = L.stats();
+    assert(st.bytes_used == sizeof(L) && st.payload_bytes == 0);
+    assert(st.allocations == 0 && st.deallocations == 0);
+    assert(DList<ItemType>::node_overhead() >= 2 * sizeof(void*));
+
+    for (int i = 0; i < 10; ++i) L.append(i);
+    L.pop();
+    L.append(9); // reuses the cached node
+    st = L.stats();
+    assert(st.live_nodes == 10 && st.cached_nodes == 0);
+    assert(st.allocations == 10 && st.deallocations == 0);
+    assert(st.payload_bytes == 10 * sizeof(ItemType));
+    assert(st.payload_bytes + st.structural_bytes == st.bytes_used);
+    assert(L.bytes_used() == sizeof(L) + 10 * (sizeof(ItemType) + DList<ItemType>::node_overhead()));
+
+    L.clear();
+    st = L.stats();
+    assert(st.live_nodes == 0 && st.cached_nodes == 10 && st.deallocations == 0);
+    L.shrink_to_fit();
+    st = L.stats();
+    assert(st.deallocations == 10 && st.bytes_used == sizeof(L));
+
+    auto balanced = [](const DList<ItemType>& list) {
+        DListStats s = list.stats();
+        return s.allocations - s.deallocations == s.live_nodes + s.cached_nodes;
+    };
+    DList<ItemType> M;
+    for (int i = 0; i < 10; ++i) L.append(i);
+    M.splice(0, L, 2, 5);
+    M.extend(std::move(L));
+    assert(balanced(L) && balanced(M) && M.length() == 10);
+    assert(L.stats().allocations == 10 && L.stats().deallocations == 10);
+    assert(M.stats().allocations == 10 && M.stats().deallocations == 0);
+    L.append(M.extract(0));
+    L.insert(0, M.extract(-1));
+    assert(balanced(L) && balanced(M) && L.length() == 2 && M.length() == 8);
+    {
+        auto dropped = M.extract(0); // freed by the handle, counted by neither list
+    }
+    assert(balanced(M) && M.stats().allocations == 7 && M.stats().deallocations == 0);
+    L.clear();
+    M.clear();
+    L.shrink_to_fit();
+    M.shrink_to_fit();
+    assert(balanced(L) && balanced(M));
+
+    UnrolledDList<ItemType> U;
+    SmallDList<ItemType> S;
+    PooledDList<ItemType> P;
+    SoADList<ItemType> A;
+    size_t u0 = U.bytes_used(), s0 = S.bytes_used(), p0 = P.bytes_used(), a0 = A.bytes_used();
+    for (int i = 0; i < 100; ++i) {
+        U.append(i);
+        S.append(i);
+        P.append(i);
+        A.append(i);
+    }
+    assert(U.bytes_used() > u0 && S.bytes_used() > s0 && P.bytes_used() > p0 && A.bytes_used() > a0);
+}
+
+// ------------------------------------------
+// Tests for DListArena
+// ------------------------------------------
+// Edge cases covered:
+//  - Many small lists share a handful of slabs
+//  - Lists on the arena keep no node cache, so nodes freed by one list are reused by
+//    other lists of the same item type, including lists created afterwards
+//  - Blocks larger than a node bypass the slabs and are returned individually
+//  - release() returns every slab to upstream
+//  - In release-only mode lists of trivially destructible items leave their nodes to
+//    release() when destroyed, while lists of other items still free theirs
+template <typename ItemType>
+static void test_arena() {
+    std::cout << "[DListArena] shared slabs for many lists\n";
+    DListArena arena(4096);
+    {
+        std::vector<pmr::DList<ItemType>> lists;
+        lists.reserve(1000); // a copied pmr::DList would not keep the arena
+        for (int i = 0; i < 1000; ++i) {
+            lists.emplace_back(&arena);
+            for (int j = 0; j < 3; ++j) lists.back().append(i + j);
+        }
+        for (int i = 0; i < 1000; i += 100) expect_contents(lists[i], {i, i + 1, i + 2});
+        assert(lists[0].get_allocator().resource() == &arena);
+        size_t slabs = arena.slab_count();
+        assert(slabs > 0 && slabs < 100);
+
+        for (auto& L : lists) L.clear();
+        assert(lists[0].stats().cached_nodes == 0);
+        for (int i = 0; i < 1000; ++i) lists[999 - i].append(i);
+        std::vector<pmr::DList<ItemType>> more;
+        more.reserve(1000);
+        for (int i = 0; i < 1000; ++i) {
+            more.emplace_back(&arena);
+            more.back().append(i);
+            more.back().append(i);
+        }
+        assert(arena.slab_count() == slabs); // freed nodes were reused
+
+        pmr::DList<std::pmr::string> strings(&arena);
+        strings.append(std::pmr::string(600, 'x', &arena)); // large block
+        strings.pop();
+        assert(arena.slab_count() == slabs);
+    }
+    assert(arena.bytes_reserved() > 0);
+    arena.release();
+    assert(arena.slab_count() == 0 && arena.bytes_reserved() == 0);
+
+    arena.set_release_only(true);
+    assert(arena.release_only());
+    for (int round = 1; round <= 2; ++round) {
+        pmr::DList<ItemType> L(&arena);
+        for (int i = 0; i < 1000; ++i) L.append(i);
+        assert(L[500] == 500);
+    }
+    size_t slabs = arena.slab_count();
+    assert(slabs > 1);
+    {
+        pmr::DList<ItemType> L(&arena);
+        for (int i = 0; i < 1000; ++i) L.append(i);
+    }
+    assert(arena.slab_count() > slabs); // the destroyed lists returned no nodes
+    for (int round = 1; round <= 2; ++round) {
+        pmr::DList<std::pmr::string> strings(&arena);
+        for (int i = 0; i < 100; ++i) strings.append(std::pmr::string("s", &arena));
+        if (round == 1) slabs = arena.slab_count();
+    }
+    assert(arena.slab_count() == slabs); // string nodes are still freed and reused
+    arena.release();
+    assert(arena.slab_count() == 0 && arena.bytes_reserved() == 0);
+}
+
+/* -----------------------------------------------------------
+   storage backends: randomized comparison against std::vector
+   ----------------------------------------------------------- */
+
+// Helper: item for a small integer key, so generated lists contain duplicates
+template <typename ItemType> static ItemType make_item(int key) { return static_cast<ItemType>(key); }
+template <> std::string make_item<std::string>(int key) { return "item" + std::to_string(key); }
+
+// Helper: check that a list with the DList interface holds exactly v
+template <typename ListType, typename ItemType>
+static void expect_same(const ListType& L, const std::vector<ItemType>& v) {
+    assert(L.length() == v.size());
+    for (size_t i = 0; i < v.size(); ++i) {
+        assert(L[static_cast<long>(i)] == v[i]);
+        assert(L[static_cast<long>(i) - static_cast<long>(v.size())] == v[i]);
+    }
+}
+
+// Applies a few thousand random operations of the DList interface to ListType and
+// to a std::vector model with Python list semantics, comparing after each step.
+// Edge cases covered:
+//  - insert at negative / out-of-range positions (clamping)
+//  - pop at positive and negative positions, remove of present and missing values
+//  - index with start offsets, count, self-extend, copy and assignment, clear
+template <typename ListType, typename ItemType>
+static void test_backend(const char* name) {
+    std::cout << "[" << name << "] randomized comparison with std::vector\n";
+    std::mt19937 rng(12345);
+    auto rand_int = [&](long lo, long hi) { return std::uniform_int_distribution<long>(lo, hi)(rng); };
+
+    ListType L;
+    std::vector<ItemType> v;
+    for (int step = 0; step < 4000; ++step) {
+        long n = static_cast<long>(v.size());
+        ItemType x = make_item<ItemType>(static_cast<int>(rand_int(0, 20)));
+        switch (rand_int(0, 9)) {
+        case 0: case 1:
+            L.append(x);
+            v.push_back(x);
+            break;
+        case 2: case 3: {
+            long pos = rand_int(-n - 3, n + 3);
+            L.insert(pos, x);
+            long p = pos < 0 ? pos + n : pos;
+            p = p < 0 ? 0 : (p > n ? n : p);
+            v.insert(v.begin() + p, x);
+            break;
+        }
+        case 4: case 5:
+            if (n > 0) {
+                long pos = rand_int(-n, n - 1);
+                long p = pos < 0 ? pos + n : pos;
+                assert(L.pop(pos) == v[p]);
+                v.erase(v.begin() + p);
+            }
+            break;
+        case 6: {
+            L.remove(x);
+            for (auto it = v.begin(); it != v.end(); ++it) {
+                if (*it == x) { v.erase(it); break; }
+            }
+            break;
+        }
+        case 7: {
+            size_t start = static_cast<size_t>(rand_int(0, n + 1));
+            size_t expected = NOT_FOUND;
+            for (size_t i = start; i < v.size(); ++i) {
+                if (v[i] == x) { expected = i; break; }
+            }
+            assert(L.index(x, start) == expected);
+            int c = 0;
+            for (auto& y : v) c += (y == x);
+            assert(L.count(x) == c);
+            break;
+        }
+        case 8:
+            if (n < 200) {
+                L.extend(L);
+                std::vector<ItemType> w(v);
+                v.insert(v.end(), w.begin(), w.end());
+            }
+            else {
+                ListType C(L);
+                expect_same(C, v);
+                ListType D;
+                D.append(x);
+                D = C;
+                L.clear();
+                expect_same(D, v);
+                v.clear();
+            }
+            break;
+        default:
+            if (n > 0) {
+                long pos = rand_int(0, n - 1);
+                L[pos] = x;
+                v[pos] = x;
+            }
+            break;
+        }
+        assert(L.length() == v.size());
+        if (step % 50 == 0) expect_same(L, v);
+    }
+    expect_same(L, v);
+}
+
+// ------------------------------------------------------
+// Tests for backend copy/move assignment on pmr resources
+// ------------------------------------------------------
+// Edge cases covered:
+//  - copy and move assignment compile with std::pmr::polymorphic_allocator
+//  - the target keeps its own resource (pmr allocators do not propagate)
+//  - move assignment between different resources copies the items
+//  - a moved-from list is still usable
+template <typename ListType, typename ItemType>
+static void test_backend_pmr(const char* name) {
+    std::cout << "[" << name << "] pmr copy and move assignment\n";
+    std::pmr::unsynchronized_pool_resource poolA, poolB;
+    std::vector<ItemType> v;
+    ListType A(&poolA);
+    for (int i = 0; i < 40; ++i) {
+        A.append(make_item<ItemType>(i));
+        v.push_back(make_item<ItemType>(i));
+    }
+
+    ListType B(&poolB);
+    B.append(make_item<ItemType>(99));
+    B = A;
+    expect_same(A, v);
+    expect_same(B, v);
+    assert(B.get_allocator().resource() == &poolB);
+
+    ListType C(&poolA);
+    C.append(make_item<ItemType>(98));
+    C = std::move(B);
+    expect_same(C, v);
+    assert(C.get_allocator().resource() == &poolA);
+
+    ListType D(&poolA);
+    D = std::move(C);
+    expect_same(D, v);
+    assert(D.get_allocator().resource() == &poolA);
+
+    B.clear();
+    B.append(make_item<ItemType>(1));
+    assert(B.length() == 1 && B[0] == make_item<ItemType>(1));
+    C = D;
+    expect_same(C, v);
+}
+
+// ------------------------------------------
+// Tests for UnrolledDList copy and move
+// ------------------------------------------
+// Edge cases covered:
+//  - An item copy that throws in the copy constructor frees every chunk (no leak)
+//  - operator= leaves the target empty and usable after a throwing copy
+//  - Move construction takes the chunks and leaves the source empty and usable
+//  - Move assignment between equal allocators takes the chunks
+template <typename ItemType>
+static void test_unrolled_list() {
+    std::cout << "[UnrolledDList] copy and move\n";
+    using Item = ThrowingCopy<ItemType>;
+    UnrolledDList<Item, 4> a;
+    for (int i = 0; i < 10; ++i) a.append(Item(static_cast<ItemType>(i)));
+
+    Item::copies_left = 6; // throws in the second chunk
+    bool threw = false;
+    try {
+        UnrolledDList<Item, 4> b(a);
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    Item::copies_left = -1;
+    UnrolledDList<Item, 4> c;
+    c.append(Item(static_cast<ItemType>(9)));
+    Item::copies_left = 2;
+    threw = false;
+    try {
+        c = a;
+    }
+    catch (const std::runtime_error&) {
+        threw = true;
+    }
+    Item::copies_left = -1;
+    assert(threw && c.length() == 0);
+    c.append(Item(static_cast<ItemType>(7)));
+    assert(c.length() == 1 && c[0].value == 7);
+
+    UnrolledDList<Item, 4> d(std::move(a));
+    assert(d.length() == 10 && a.length() == 0 && d[9].value == 9);
+    a.append(Item(static_cast<ItemType>(1)));
+    assert(a.length() == 1 && a[0].value == 1);
+    c = std::move(d);
+    assert(c.length() == 10 && d.length() == 0 && c[-1].value == 9 && c[4].value == 4);
+}
+
+// ------------------------------------------
+// Tests for SmallDList inline storage
+// ------------------------------------------
+// Edge cases covered:
+//  - Lists up to InlineCapacity items never touch the allocator, copies included
+//  - Overflow by append and by insert moves every item to linked nodes in order
+//  - Popping a spilled list empty, or clearing it, returns to inline storage and
+//    frees the linked list
+//  - A copy that throws frees the items and the linked list copied so far (the copy constructor delegates, so the destructor runs)
+//  - The object is smaller than the DList it spills into
+template <typename ItemType>
+static void test_small_list() {
+    std::cout << "[SmallDList] inline storage and spilling\n";
+    long live = 0;
+    using Small = SmallDList<ItemType, 4, CountingAllocator<ItemType>>;
+    Small L{CountingAllocator<ItemType>(&live)};
+    for (int i = 1; i <= 4; ++i) L.insert(0, i);
+    Small C(L);
+    L.remove(3);
+    L.insert(-1, 30);
+    assert(live == 0 && !L.spilled() && !C.spilled());
+    expect_same(L, std::vector<ItemType>{4,2,30,1});
+    expect_same(C, std::vector<ItemType>{4,3,2,1});
+
+    L.insert(1, 5);
+    assert(L.spilled() && live > 0);
+    expect_same(L, std::vector<ItemType>{4,5,2,30,1});
+    while (L.length() > 0) L.pop(0);
+    assert(!L.spilled() && live == 0);
+
+    C.append(0);
+    assert(C.spilled());
+    expect_same(C, std::vector<ItemType>{4,3,2,1,0});
+    Small D(C);
+    assert(D.spilled());
+    expect_same(D, std::vector<ItemType>{4,3,2,1,0});
+    C.clear();
+    assert(!C.spilled() && C.length() == 0);
+    C.append(7);
+    expect_same(C, std::vector<ItemType>{7});
+    D = C;
+    assert(!D.spilled());
+    expect_same(D, std::vector<ItemType>{7});
+    assert(live == 0);
+
+    using Item = ThrowingCopy<ItemType>;
+    using Throwing = SmallDList<Item, 2, CountingAllocator<Item>>;
+    Throwing inlineItems{CountingAllocator<Item>(&live)}, spilledItems{CountingAllocator<Item>(&live)};
+    inlineItems.append(Item(static_cast<ItemType>(1)));
+    inlineItems.append(Item(static_cast<ItemType>(2)));
+    for (int i = 0; i < 5; ++i) spilledItems.append(Item(static_cast<ItemType>(i)));
+    long sourceAllocations = live;
+    for (auto* source : {&inlineItems, &spilledItems}) {
+        Item::copies_left = 1; // the second copy throws
+        bool threw = false;
+        try {
+            Throwing copy(*source);
+        }
+        catch (const std::runtime_error&) {
+            threw = true;
+        }
+        Item::copies_left = -1;
+        assert(threw);
+        assert(live == sourceAllocations && Item::instances == 7);
+    }
+
+    static_assert(sizeof(SmallDList<ItemType, 8>) < sizeof(DList<ItemType>),
+                  "a short list must be cheaper than a DList");
+}
+
+// ------------------------------------------
+// Tests for PooledDList's index-linked pool
+// ------------------------------------------
+// Edge cases covered:
+//  - Removed slots are reused before the pool grows
+//  - Growing the pool relocates the items without changing the order
+//  - A copy of a trivially copyable list (byte copy of the pool) is independent
+//  - clear() keeps the capacity
+template <typename ItemType>
+static void test_pooled_list() {
+    std::cout << "[PooledDList] slot reuse, relocation and copies\n";
+    PooledDList<ItemType> L;
+    L.reserve(4);
+    assert(L.capacity() == 4);
+    for (int i = 0; i < 4; ++i) L.append(i);
+    L.pop(1);
+    L.remove(2);
+    L.insert(0, 10);
+    L.insert(-1, 20);
+    assert(L.capacity() == 4);
+    expect_same(L, std::vector<ItemType>{10,0,20,3});
+
+    for (int i = 0; i < 100; ++i) L.insert(2, L[-1] + i);
+    assert(L.capacity() >= 104 && L.length() == 104);
+    assert(L[0] == 10 && L[1] == 0 && L[-2] == 20 && L[-1] == 3);
+
+    PooledDList<ItemType> C(L);
+    C[0] = 11;
+    assert(L[0] == 10 && C[0] == 11 && C.length() == 104);
+    size_t capacity = L.capacity();
+    L.clear();
+    assert(L.capacity() == capacity && L.length() == 0);
+    assert(C.count(3) == 2);
+}
+
+// ------------------------------------------
+// Tests for SoADList's slot compaction
+// ------------------------------------------
+// Edge cases covered:
+//  - Removing the head item moves the last slot (the tail) into slot 0
+//  - Removing an item that already occupies the last slot moves nothing
+//  - Removing the tail item moves a middle item out of the last slot
+//  - Removing the only item leaves a usable empty list
+//  - Links stay consistent after each compaction: both ends, inserts and count
+//  - Arrays come from a pmr resource and copies keep working
+template <typename ItemType>
+static void test_soa_list() {
+    std::cout << "[SoADList] slot compaction and pmr arrays\n";
+    SoADList<ItemType> L;
+    for (int i = 0; i < 5; ++i) L.append(i); // slot i holds i
+    assert(L.pop(0) == 0);                   // the tail moves from slot 4 into slot 0
+    expect_same(L, std::vector<ItemType>{1,2,3,4});
+    L.append(5);
+    assert(L[-2] == 4 && L[-1] == 5);
+    assert(L.pop() == 5 && L.pop() == 4);    // the last slot, then slot 0
+    expect_same(L, std::vector<ItemType>{1,2,3});
+
+    L.insert(0, 7);                          // the head occupies the last slot
+    L.remove(7);
+    expect_same(L, std::vector<ItemType>{1,2,3});
+    L.insert(0, 8);
+    L.insert(-1, 9);                         // the last slot is now a middle item
+    L.remove(3);                             // the tail is not in the last slot
+    expect_same(L, std::vector<ItemType>{8,1,2,9});
+    assert(L[-1] == 9 && L.index(9) == 3 && L.count(3) == 0);
+    L.insert(-1, 3);
+    L.append(3);
+    expect_same(L, std::vector<ItemType>{8,1,2,3,9,3});
+    assert(L.count(3) == 2 && L.index(3, 4) == 5);
+    L.remove(42);
+    assert(L.index(42) == static_cast<size_t>(-1) && L.length() == 6);
+
+    SoADList<ItemType> one;
+    one.append(1);
+    one.remove(1);
+    assert(one.length() == 0 && one.pop() == ItemType{});
+    one.insert(5, 2);
+    one.insert(-5, 1);
+    expect_same(one, std::vector<ItemType>{1,2});
+
+    std::pmr::unsynchronized_pool_resource pool;
+    SoADList<ItemType, std::pmr::polymorphic_allocator<ItemType>> P(&pool);
+    for (int i = 0; i < 100; ++i) P.insert(i / 2, i);
+    for (int i = 0; i < 100; i += 3) P.remove(i);
+    auto C = P;
+    assert(P.get_allocator().resource() == &pool && C.length() == P.length());
+    for (long i = 0; i < static_cast<long>(P.length()); ++i) assert(C[i] == P[i] && C[i] % 3 != 0);
+    assert(C.count(1) == 1 && C.count(3) == 0);
+}
+
+// ---------------------------------------------------
+// Tests for RopeDList::split / extend(RopeDList&&)
+// ---------------------------------------------------
+// Edge cases covered:
+//  - split at the front, middle, end, negative and out-of-range positions
+//  - consuming extend leaves the source empty and keeps order
+//  - cut-and-paste of a run back into the middle of a list
+template <typename ItemType>
+static void test_rope_split_concat() {
+    std::cout << "[RopeDList::split/extend] logarithmic cut and paste\n";
+    RopeDList<ItemType> L;
+    std::vector<ItemType> v;
+    for (int i = 0; i < 1000; ++i) {
+        L.append(i);
+        v.push_back(i);
+    }
+
+    RopeDList<ItemType> tail = L.split(600);
+    expect_same(L, std::vector<ItemType>(v.begin(), v.begin() + 600));
+    expect_same(tail, std::vector<ItemType>(v.begin() + 600, v.end()));
+    L.extend(std::move(tail));
+    assert(tail.length() == 0);
+    expect_same(L, v);
+
+    assert(L.split(5000).length() == 0 && L.length() == 1000);
+    RopeDList<ItemType> all = L.split(-5000);
+    assert(L.length() == 0 && all.length() == 1000);
+    RopeDList<ItemType> last = all.split(-1);
+    expect_same(last, std::vector<ItemType>{999});
+    all.extend(std::move(last));
+
+    // move items [100, 300) to the front
+    RopeDList<ItemType> rest = all.split(100);
+    RopeDList<ItemType> after = rest.split(200);
+    rest.extend(std::move(all));
+    rest.extend(std::move(after));
+    std::vector<ItemType> w(v.begin() + 100, v.begin() + 300);
+    w.insert(w.end(), v.begin(), v.begin() + 100);
+    w.insert(w.end(), v.begin() + 300, v.end());
+    expect_same(rest, w);
+}
+
+// ---------------------------------------------------
+// Tests for RopeDList balance after repeated self-extend
+// ---------------------------------------------------
+// Edge cases covered:
+//  - 20 self-extends of a one-item rope (about 1M items) neither overflow the stack
+//    nor unbalance the tree: its height stays within a small multiple of log2(n), as
+//    does that of a rope of the same size built by append, before and after middle
+//    inserts and pops
+//  - the items stay in order and equal the original item
+//  - height() of an empty and a one-item rope
+template <typename ItemType>
+static void test_rope_self_extend() {
+    std::cout << "[RopeDList::extend] balance after repeated self-extend\n";
+    RopeDList<ItemType> doubled;
+    doubled.append(7);
+    for (int i = 0; i < 20; ++i) doubled.extend(doubled);
+    assert(doubled.length() == (size_t{1} << 20));
+    assert(doubled[0] == 7 && doubled[1 << 19] == 7 && doubled[-1] == 7);
+
+    RopeDList<ItemType> appended;
+    for (long i = 0; i < (1L << 20); ++i) appended.append(7);
+
+    // a treap's expected height is about 3 * log2(n); a degenerate one would be near n
+    const size_t maxHeight = 4 * 20;
+    auto middle_ops = [](RopeDList<ItemType>& L) {
+        for (int i = 0; i < 20000; ++i) {
+            long middle = static_cast<long>(L.length() / 2) + i % 1000;
+            L.insert(middle, 1);
+            assert(L.pop(middle) == 1);
+        }
+    };
+    for (auto* L : {&appended, &doubled}) {
+        assert(L->height() <= maxHeight);
+        middle_ops(*L);
+        assert(L->height() <= maxHeight);
+    }
+    assert(doubled.count(7) == (1 << 20));
+
+    RopeDList<ItemType> small;
+    assert(small.height() == 0);
+    small.append(1);
+    assert(small.height() == 1);
+}
+
+/* -----------------------------------
+   CowDList: copy-on-write sharing
+   ----------------------------------- */
+
+// --------------------------------------
+// Tests for CowDList sharing and cloning
+// --------------------------------------
+// Edge cases covered:
+//  - Copies share one list without allocating
+//  - Each kind of mutation (append, insert, pop, remove, clear, extend, non-const
+//    operator[]) gives the mutated copy its own clone and leaves the others unchanged
+//  - Mutations that change nothing (pop out of range, remove of an absent value)
+//    keep sharing
+//  - An unshared list is mutated in place
+//  - A new list allocates nothing until it is first modified
+//  - Moves are noexcept and allocate nothing; a moved-from list is empty and usable
+//  - A pmr list, its copies and their clones stay on its resource
+template <typename ItemType>
+static void test_cow_list() {
+    std::cout << "[CowDList] copy-on-write sharing\n";
+    long live = 0;
+    using Alloc = CountingAllocator<ItemType>;
+    using List = CowDList<ItemType, Alloc>;
+    List a{Alloc(&live)};
+    List c{Alloc(&live)};
+    for (int i = 0; i < 5; ++i) a.append(i);
+    assert(c.use_count() == 0 && c.bytes_used() == sizeof(c)); // c has allocated nothing yet
+    c = a;
+    long base = live;
+
+    List b(a);
+    assert(live == base && a.use_count() == 3);
+    assert(std::as_const(b)[2] == 2 && c.length() == 5 && b.count(3) == 1 && c.index(4) == 4);
+
+    assert(b.pop(10) == ItemType{});
+    b.remove(42);
+    assert(a.use_count() == 3 && live == base);
+
+    b.append(5);
+    assert(a.use_count() == 2 && b.use_count() == 1 && live > base);
+    expect_same(a, std::vector<ItemType>({0, 1, 2, 3, 4}));
+    expect_same(b, std::vector<ItemType>({0, 1, 2, 3, 4, 5}));
+
+    c[0] = 100;
+    expect_same(c, std::vector<ItemType>({100, 1, 2, 3, 4}));
+    expect_same(a, std::vector<ItemType>({0, 1, 2, 3, 4}));
+    assert(a.use_count() == 1);
+
+    List d(a), e(a), f(a), g(a);
+    d.insert(0, -1);
+    assert(e.pop() == 4);
+    f.remove(2);
+    g.extend(g);
+    expect_same(d, std::vector<ItemType>({-1, 0, 1, 2, 3, 4}));
+    expect_same(e, std::vector<ItemType>({0, 1, 2, 3}));
+    expect_same(f, std::vector<ItemType>({0, 1, 3, 4}));
+    expect_same(g, std::vector<ItemType>({0, 1, 2, 3, 4, 0, 1, 2, 3, 4}));
+    expect_same(a, std::vector<ItemType>({0, 1, 2, 3, 4}));
+
+    List h(a);
+    h.append(h[0]);
+    h.extend(a);
+    a.clear();
+    assert(a.length() == 0 && h.length() == 11 && h[5] == 0 && h[-1] == 4);
+
+    long before = live;
+    h.append(7);
+    h.insert(0, 8);
+    assert(h.use_count() == 1 && live == before + 2);
+
+    List m(std::move(h));
+    assert(m.length() == 13 && h.length() == 0 && h.use_count() == 0);
+    h.append(1);
+    assert(h.length() == 1 && h[0] == 1 && h.count(1) == 1);
+    List n{Alloc(&live)};
+    n = std::move(m);
+    assert(n.length() == 13 && m.length() == 0 && m.get_allocator() == n.get_allocator());
+    m.extend(n);
+    assert(m.length() == 13 && m.use_count() == 1 && n.use_count() == 1);
+    static_assert(std::is_nothrow_move_constructible<List>::value, "a move must not allocate");
+    static_assert(std::is_nothrow_move_assignable<CowDList<ItemType>>::value, "a move must not allocate");
+
+    using PmrList = CowDList<ItemType, std::pmr::polymorphic_allocator<ItemType>>;
+    std::pmr::unsynchronized_pool_resource pool;
+    auto* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        PmrList p(&pool);
+        for (int i = 0; i < 5; ++i) p.append(i);
+        PmrList q(p);
+        q[0] = 10;                      // clones q's list on the pool
+        PmrList r(std::move(q));
+        r.append(5);
+        assert(q.length() == 0 && p.use_count() == 1);
+        assert(p.get_allocator().resource() == &pool && r.get_allocator().resource() == &pool);
+        expect_same(p, std::vector<ItemType>({0, 1, 2, 3, 4}));
+        expect_same(r, std::vector<ItemType>({10, 1, 2, 3, 4, 5}));
+    }
+    std::pmr::set_default_resource(previous);
+}
+
+// ------------------------------------------------
+// Tests for CowDList copies used on several threads
+// ------------------------------------------------
+// Edge cases covered:
+//  - Threads copying one list and reading their copies at once, while the original
+//    is read too, all see the same items
+//  - Threads mutating their copies clone and leave the shared list unchanged
+//  - Once the copies are gone the original is the sole owner again
+template <typename ItemType>
+static void test_cow_threads() {
+    std::cout << "[CowDList] copies on several threads\n";
+    const long n = 2000;
+    CowDList<ItemType> shared;
+    long expected = 0;
+    for (long i = 0; i < n; ++i) {
+        shared.append(static_cast<ItemType>(i));
+        if (i % 7 == 0) expected += i;
+    }
+
+    std::vector<long> sums(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&shared, &sums, t, n] {
+            CowDList<ItemType> mine(shared);
+            const CowDList<ItemType>& view = mine;
+            long sum = 0;
+            for (long i = 0; i < n; i += 7) sum += static_cast<long>(view[i]);
+            assert(view.index(static_cast<ItemType>(n - 1)) == static_cast<size_t>(n - 1) && view.count(5) == 1);
+            if (t % 2 == 1) {
+                mine.append(static_cast<ItemType>(t));
+                mine.remove(static_cast<ItemType>(0));
+                assert(mine.length() == static_cast<size_t>(n) && mine[-1] == static_cast<ItemType>(t));
+            }
+            sums[t] = sum;
+        });
+    }
+    long mainSum = 0;
+    for (long i = 0; i < n; i += 7) mainSum += static_cast<long>(std::as_const(shared)[i]);
+    for (auto& thread : threads) thread.join();
+
+    assert(mainSum == expected);
+    for (long sum : sums) assert(sum == expected);
+    assert(shared.use_count() == 1 && shared.length() == static_cast<size_t>(n));
+    assert(shared[0] == ItemType{} && shared[-1] == static_cast<ItemType>(n - 1));
+}
+
 /* ---------------------------
    std::string focused tests
    --------------------------- */
@@ -516,12 +2136,203 @@ static void test_double_index() {
     assert(L.index(42.42, 0) == NOT_FOUND);
 }
 
-int main() {
+/* -----------------------
+   benchmarks (--bench)
+   ----------------------- */
+
+// Elapsed wall-clock seconds since start
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Clears lists of 12.5M, 25M and 50M nodes; the per-node cost must stay flat
+// (linear teardown) and none of them may crash.
+static void bench_clear() {
+    std::cout << "[bench] DList::clear teardown\n";
+    double first_per_node = 0;
+    for (long n = 12500000; n <= 50000000; n *= 2) {
+        DList<int> L;
+        for (long i = 0; i < n; ++i) L.append(static_cast<int>(i));
+        auto start = std::chrono::steady_clock::now();
+        L.clear();
+        double elapsed = seconds_since(start);
+        double per_node = elapsed / static_cast<double>(n) * 1e9;
+        std::cout << "  n=" << n << "  clear " << elapsed << " s  (" << per_node << " ns/node)\n";
+        if (first_per_node == 0) first_per_node = per_node;
+        assert(L.length() == 0);
+        assert(per_node < 3 * first_per_node);
+    }
+}
+
+// Seconds per lookup when lookups alternate between index 0 and index far; returning
+// to 0 each time keeps the finger from shortening the walk to far
+template <typename Lookup>
+static double alternating_lookup_seconds(Lookup lookup, long far, int lookups) {
+    auto start = std::chrono::steady_clock::now();
+    long sum = 0;
+    for (int k = 0; k < lookups; ++k) sum += lookup((k & 1) * far);
+    double elapsed = seconds_since(start);
+    assert(sum != -1);
+    return elapsed / lookups;
+}
+
+// Compares the farthest walk of operator[] (nearest of head, tail and finger: the
+// middle) with the farthest walk of a head-only lookup (the last item). The head-only
+// lookup is a plain pointer walk from the head over a chain of nodes laid out like
+// DList's (item, next, prev), allocated in the same order, as every lookup walked
+// before _seek. At the middle both walk the same number of nodes.
+static void bench_seek_worst_case() {
+    std::cout << "[bench] worst-case positional seek\n";
+    const long n = 1000;
+    const int lookups = 200000;
+    static_assert(n < DList<int>::directory_min_length, "the directory would shorten the walks");
+    DList<int> L;
+    for (long i = 0; i < n; ++i) L.append(static_cast<int>(i));
+
+    struct Node {
+        int item;
+        Node* next;
+        Node* prev;
+    };
+    std::vector<std::unique_ptr<Node>> nodes;
+    for (long i = 0; i < n; ++i) {
+        nodes.push_back(std::unique_ptr<Node>(new Node{static_cast<int>(i), nullptr, nullptr}));
+        if (i > 0) {
+            nodes[i - 1]->next = nodes[i].get();
+            nodes[i]->prev = nodes[i - 1].get();
+        }
+    }
+    Node* head = nodes.front().get();
+
+    auto seek = [&](long i) { return static_cast<long>(L[i]); };
+    auto headOnly = [&](long i) {
+        Node* node = head;
+        for (long k = 0; k < i; ++k) node = node->next;
+        return static_cast<long>(node->item);
+    };
+
+    double seekMiddle = alternating_lookup_seconds(seek, n / 2, lookups);
+    double headMiddle = alternating_lookup_seconds(headOnly, n / 2, lookups);
+    double headLast = alternating_lookup_seconds(headOnly, n - 1, lookups);
+    std::cout << "  n=" << n << ": index n/2: operator[] " << seekMiddle * 1e9 << " ns, head-only "
+              << headMiddle * 1e9 << " ns\n";
+    std::cout << "  worst case: operator[] " << seekMiddle * 1e9 << " ns (index n/2), head-only "
+              << headLast * 1e9 << " ns (index n-1), " << headLast / seekMiddle << "x\n";
+    assert(headLast > 1.5 * seekMiddle); // about twice the nodes walked
+}
+
+// Sums a 1M-element list through operator[] in index order, both directions
+static void bench_index_sweep() {
+    std::cout << "[bench] operator[] index sweep\n";
+    const long n = 1000000;
+    DList<int> L;
+    for (long i = 0; i < n; ++i) L.append(1);
+    auto start = std::chrono::steady_clock::now();
+    long sum = 0;
+    for (long i = 0; i < n; ++i) sum += L[i];
+    for (long i = n - 1; i >= 0; --i) sum += L[i];
+    double elapsed = seconds_since(start);
+    assert(sum == 2 * n);
+    std::cout << "  2 x " << n << " sequential lookups: " << elapsed << " s\n";
+}
+
+// Times random-position operator[], insert and pop on a list of n ints
+template <typename ListType>
+static void bench_positional_list(const char* name, long n, int ops) {
+    ListType L;
+    for (long i = 0; i < n; ++i) L.append(static_cast<int>(i));
+    std::mt19937 rng(7);
+    auto start = std::chrono::steady_clock::now();
+    long sum = 0;
+    for (int k = 0; k < ops; ++k) {
+        long size = static_cast<long>(L.length());
+        long pos = std::uniform_int_distribution<long>(0, size - 1)(rng);
+        sum += L[pos];
+        L.insert(pos, k);
+        sum += L.pop(std::uniform_int_distribution<long>(0, size)(rng));
+    }
+    double elapsed = seconds_since(start);
+    assert(L.length() == static_cast<size_t>(n) && sum != -1);
+    std::cout << "  " << name << "  n=" << n << ": " << elapsed / ops * 1e6 << " us per get+insert+pop\n";
+}
+
+// Compares positional operations of the linked DList and the skip list, 10^3..10^7 items
+static void bench_positional() {
+    std::cout << "[bench] random-position access, insert and pop\n";
+    for (long n = 1000; n <= 10000000; n *= 10) {
+        int ops = n >= 1000000 ? 100 : 1000;
+        bench_positional_list<DList<int>>("DList<int>    ", n, ops);
+        bench_positional_list<SkipDList<int>>("SkipDList<int>", n, ops);
+        bench_positional_list<RopeDList<int>>("RopeDList<int>", n, ops);
+    }
+}
+
+// Cuts a run out of a 10M-item rope and pastes it back elsewhere
+static void bench_rope_cut_paste() {
+    std::cout << "[bench] RopeDList split/extend\n";
+    const long n = 10000000;
+    RopeDList<int> L;
+    for (long i = 0; i < n; ++i) L.append(static_cast<int>(i));
+    std::mt19937 rng(3);
+    const int ops = 10000;
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < ops; ++k) {
+        long a = std::uniform_int_distribution<long>(0, n - 1)(rng);
+        RopeDList<int> run = L.split(a);
+        RopeDList<int> rest = run.split(std::uniform_int_distribution<long>(0, n - a)(rng));
+        L.extend(std::move(rest));
+        L.extend(std::move(run));
+    }
+    double elapsed = seconds_since(start);
+    assert(L.length() == static_cast<size_t>(n));
+    std::cout << "  n=" << n << ": " << elapsed / ops * 1e6 << " us per cut+paste\n";
+}
+
+// Builds a list of n ints and times count() and index() over it
+template <typename ListType>
+static void bench_scan_list(const char* name, long n) {
+    ListType L;
+    for (long i = 0; i < n; ++i) L.append(static_cast<int>(i % 1000));
+    auto start = std::chrono::steady_clock::now();
+    int c = L.count(7);
+    size_t at = L.index(-1);
+    double elapsed = seconds_since(start);
+    assert(c == n / 1000 && at == NOT_FOUND);
+    std::cout << "  " << name << "  count+index over " << n << " items: " << elapsed << " s, "
+              << static_cast<double>(L.bytes_used()) / static_cast<double>(n) << " bytes/item\n";
+}
+
+// Compares full scans across storage backends
+static void bench_scan() {
+    std::cout << "[bench] count/index scans\n";
+    const long n = 10000000;
+    bench_scan_list<DList<int>>("DList<int>           ", n);
+    bench_scan_list<UnrolledDList<int>>("UnrolledDList<int>   ", n);
+    bench_scan_list<UnrolledDList<int, 64>>("UnrolledDList<int,64>", n);
+    bench_scan_list<PooledDList<int>>("PooledDList<int>     ", n);
+    bench_scan_list<SoADList<int>>("SoADList<int>        ", n);
+    bench_scan_list<SkipDList<int>>("SkipDList<int>       ", n);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        std::cout << "Running DList benchmarks...\n\n";
+        bench_clear();
+        bench_scan();
+        bench_index_sweep();
+        bench_seek_worst_case();
+        bench_positional();
+        bench_rope_cut_paste();
+        std::cout << "\nAll benchmarks finished.\n";
+        return 0;
+    }
+
     std::cout << "Running DList assert-based tests...\n\n";
 
     test_ctor_default<int>();
     test_ctor_copy<int>();
     test_assignment<int>();
+    test_copy_throwing<int>();
     test_append<int>();
     test_bracket_ops<int>();
     test_insert<int>();
@@ -531,6 +2342,59 @@ int main() {
     test_index<int>();
     test_count<int>();
     test_extend<int>();
+    test_clear_long<int>();
+    test_finger<int>();
+    test_directory<int>();
+    test_const_threads<int>();
+    test_get_set_many<int>();
+    test_insert_many<int>();
+    test_delete_many<int>();
+    test_slice<int>();
+    test_slice_assign_delete<int>();
+    test_move<int>();
+    test_splice<int>();
+    test_node_handle<int>();
+    test_allocator<int>();
+    test_node_cache<int>();
+    test_memory_accounting<int>();
+    test_arena<int>();
+    test_backend<DList<int>, int>("DList<int>");
+    test_backend<UnrolledDList<int, 4>, int>("UnrolledDList<int, 4>");
+    test_backend<UnrolledDList<int>, int>("UnrolledDList<int>");
+    test_backend<UnrolledDList<std::string, 3>, std::string>("UnrolledDList<std::string, 3>");
+    test_backend_pmr<UnrolledDList<std::string, 3, std::pmr::polymorphic_allocator<std::string>>, std::string>(
+        "UnrolledDList<std::string, 3, pmr>");
+    test_unrolled_list<int>();
+    test_small_list<int>();
+    test_backend<SmallDList<int>, int>("SmallDList<int>");
+    test_backend<SmallDList<std::string, 2>, std::string>("SmallDList<std::string, 2>");
+    test_backend_pmr<SmallDList<std::string, 2, std::pmr::polymorphic_allocator<std::string>>, std::string>(
+        "SmallDList<std::string, 2, pmr>");
+    test_pooled_list<int>();
+    test_backend<PooledDList<int>, int>("PooledDList<int>");
+    test_backend<PooledDList<std::string>, std::string>("PooledDList<std::string>");
+    test_backend_pmr<PooledDList<std::string, std::pmr::polymorphic_allocator<std::string>>, std::string>(
+        "PooledDList<std::string, pmr>");
+    test_backend<SoADList<int>, int>("SoADList<int>");
+    test_soa_list<int>();
+    test_backend<SoADList<double>, double>("SoADList<double>");
+    test_backend_pmr<SoADList<int, std::pmr::polymorphic_allocator<int>>, int>("SoADList<int, pmr>");
+    test_backend<SkipDList<int>, int>("SkipDList<int>");
+    test_backend<SkipDList<std::string>, std::string>("SkipDList<std::string>");
+    test_backend_pmr<SkipDList<std::string, std::pmr::polymorphic_allocator<std::string>>, std::string>(
+        "SkipDList<std::string, pmr>");
+    test_backend<RopeDList<int>, int>("RopeDList<int>");
+    test_backend<RopeDList<std::string>, std::string>("RopeDList<std::string>");
+    test_backend_pmr<RopeDList<std::string, std::pmr::polymorphic_allocator<std::string>>, std::string>(
+        "RopeDList<std::string, pmr>");
+    test_backend<CowDList<int>, int>("CowDList<int>");
+    test_backend<CowDList<std::string>, std::string>("CowDList<std::string>");
+    test_backend_pmr<CowDList<std::string, std::pmr::polymorphic_allocator<std::string>>, std::string>(
+        "CowDList<std::string, pmr>");
+    test_rope_split_concat<int>();
+    test_rope_self_extend<int>();
+    test_cow_list<int>();
+    test_cow_threads<int>();
 
     // string tests (first half)
     test_string_ctor_default<std::string>();
@@ -539,6 +2403,7 @@ int main() {
     test_string_insert<std::string>();
     test_string_extend<std::string>();
     test_string_count<std::string>();
+    test_emplace<std::string>();
 
     // double tests (second half)
     test_double_ctor_copy<double>();